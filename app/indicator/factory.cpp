@@ -21,6 +21,7 @@
 
 // local
 #include "../layouts/importer.h"
+#include "../tools/filewatcher.h"
 
 // Qt
 #include <QDebug>
@@ -32,7 +33,6 @@
 #include <QTimer>
 
 // KDE
-#include <KDirWatch>
 #include <KLocalizedString>
 #include <KNotification>
 #include <KPluginMetaData>
@@ -59,25 +59,11 @@ Factory::Factory(QObject *parent)
 
     //! track paths for changes
     for(const auto &dir : m_mainPaths) {
-        KDirWatch::self()->addDir(dir);
-    }
-
-    connect(KDirWatch::self(), &KDirWatch::dirty, this, [ & ](const QString & path) {
-        if (m_indicatorsPaths.contains(path)) {
-            //! indicator updated
-            reload(path);
-        } else if (m_mainPaths.contains(path)){
+        FileWatcher::self()->watchDir(dir, this, [&](const QString &path) {
             //! consider indicator addition
             discoverNewIndicators(path);
-        }
-    });
-
-    connect(KDirWatch::self(), &KDirWatch::deleted, this, [ & ](const QString & path) {
-        if (m_indicatorsPaths.contains(path)) {
-            //! indicator removed
-            removeIndicatorRecords(path);
-        }
-    });
+        });
+    }
 
     qDebug() << m_plugins["org.kde.latte.default"].name();
 }
@@ -190,12 +176,28 @@ void Factory::discoverNewIndicators(const QString &main)
 
         if (!m_indicatorsPaths.contains(iPath)) {
             m_indicatorsPaths << iPath;
-            KDirWatch::self()->addDir(iPath);
+            FileWatcher::self()->watchDir(iPath, this, [&](const QString &path) {
+                indicatorPathChanged(path);
+            }, FileWatcher::DirtyChange | FileWatcher::DeletedChange);
             reload(iPath);
         }
     }
 }
 
+void Factory::indicatorPathChanged(const QString &path)
+{
+    if (!m_indicatorsPaths.contains(path)) {
+        return;
+    }
+
+    //! changes are merged, an indicator that is reinstalled is just updated
+    if (QDir(path).exists()) {
+        reload(path);
+    } else {
+        removeIndicatorRecords(path);
+    }
+}
+
 void Factory::removeIndicatorRecords(const QString &path)
 {
     if (m_indicatorsPaths.contains(path)) {
@@ -211,7 +213,7 @@ void Factory::removeIndicatorRecords(const QString &path)
 
         m_indicatorsPaths.removeAll(path);
 
-        KDirWatch::self()->removeDir(path);
+        FileWatcher::self()->unwatch(path, this);
 
         //! delay informing the removal in case it is just an update
         QTimer::singleShot(1000, [this, pluginId]() {
@@ -70,6 +70,7 @@ signals:
 private:
     void reload(const QString &indicatorPath);
 
+    void indicatorPathChanged(const QString &path);
     void removeIndicatorRecords(const QString &path);
     void discoverNewIndicators(const QString &main);
 
@@ -45,7 +45,9 @@
 #include "settings/universalsettings.h"
 #include "settings/dialogs/settingsdialog.h"
 #include "templates/templatesmanager.h"
+#include "tools/filewatcher.h"
 #include "view/view.h"
+#include "view/positioner.h"
 #include "view/settings/viewsettingsfactory.h"
 #include "view/windowstracker/windowstracker.h"
 #include "view/windowstracker/allscreenstracker.h"
@@ -94,6 +96,17 @@
 
 namespace Latte {
 
+//! Types::None is -1, so visibility modes are shifted by one in their bitmask
+inline uint visibilityBit(Types::Visibility mode)
+{
+    return 1u << (static_cast<int>(mode) + 1);
+}
+
+inline uint locationBit(Plasma::Types::Location location)
+{
+    return 1u << static_cast<int>(location);
+}
+
 Corona::Corona(bool defaultLayoutOnStartup, QString layoutNameOnStartUp, int userSetMemoryUsage, QObject *parent)
     : Plasma::Corona(parent),
       m_defaultLayoutOnStartup(defaultLayoutOnStartup),
@@ -228,6 +241,11 @@ void Corona::load()
         m_templatesManager->init();
         m_layoutsManager->init();
 
+        //! memoized available screen areas depend on the views that each activity provides
+        connect(m_layoutsManager->synchronizer(), &Layouts::Synchronizer::centralLayoutsChanged, this, &Corona::invalidateAvailableScreenAreas);
+        connect(m_layoutsManager->synchronizer(), &Layouts::Synchronizer::layoutActivitiesChanged, this, &Corona::invalidateAvailableScreenAreas);
+        connect(m_layoutsManager->synchronizer(), &Layouts::Synchronizer::runningActicitiesChanged, this, &Corona::invalidateAvailableScreenAreas);
+
         connect(this, &Corona::availableScreenRectChangedFrom, this, &Plasma::Corona::availableScreenRectChanged);
         connect(this, &Corona::availableScreenRegionChangedFrom, this, &Plasma::Corona::availableScreenRegionChanged);
         connect(qGuiApp, &QGuiApplication::primaryScreenChanged, this, &Corona::primaryOutputChanged, Qt::UniqueConnection);
@@ -526,6 +544,59 @@ Layout::GenericLayout *Corona::layout(QString name) const
     return result;
 }
 
+Corona::AvailableAreaKey Corona::availableAreaKey(int id,
+                                                  const QString &activityid,
+                                                  const QList<Types::Visibility> &ignoreModes,
+                                                  const QList<Plasma::Types::Location> &ignoreEdges,
+                                                  bool ignoreExternalPanels,
+                                                  bool desktopUse) const
+{
+    AvailableAreaKey key;
+
+    if (!m_screenPool->screenForId(id)) {
+        return key;
+    }
+
+    key.screen = id;
+    key.activity = activityid.isEmpty() ? m_activitiesConsumer->currentActivity() : activityid;
+    key.ignoreExternalPanels = ignoreExternalPanels;
+    key.desktopUse = desktopUse;
+
+    //! blacklist irrelevant visibility modes
+    key.ignoredModes = visibilityBit(Latte::Types::None) | visibilityBit(Latte::Types::NormalWindow);
+
+    for (const auto mode : ignoreModes) {
+        key.ignoredModes |= visibilityBit(mode);
+    }
+
+    for (const auto edge : ignoreEdges) {
+        key.ignoredEdges |= locationBit(edge);
+    }
+
+    return key;
+}
+
+QList<Latte::View *> Corona::availableAreaViews(const AvailableAreaKey &key, const QScreen *screen) const
+{
+    QList<Latte::View *> views;
+
+    for (const auto view : m_layoutsManager->synchronizer()->viewsBasedOnActivityId(key.activity)) {
+        if (view && view->containment() && view->screen() == screen
+                && !(key.ignoredEdges & locationBit(view->location()))
+                && view->visibility() && !(key.ignoredModes & visibilityBit(view->visibility()->mode()))) {
+            views << view;
+        }
+    }
+
+    return views;
+}
+
+void Corona::invalidateAvailableScreenAreas()
+{
+    m_availableScreenRects.clear();
+    m_availableScreenRegions.clear();
+}
+
 QRegion Corona::availableScreenRegion(int id) const
 {
     return availableScreenRegionWithCriteria(id);
@@ -538,174 +609,161 @@ QRegion Corona::availableScreenRegionWithCriteria(int id,
                                                   bool ignoreExternalPanels,
                                                   bool desktopUse) const
 {
-    const QScreen *screen = m_screenPool->screenForId(id);
-    bool inCurrentActivity{activityid.isEmpty()};
+    const AvailableAreaKey key = availableAreaKey(id, activityid, ignoreModes, ignoreEdges, ignoreExternalPanels, desktopUse);
 
-    if (!screen) {
+    if (key.screen < 0) {
         return {};
     }
 
-    QRegion available = ignoreExternalPanels ? screen->geometry() : screen->availableGeometry();
-
-    QList<Latte::View *> views;
+    auto cached = m_availableScreenRegions.constFind(key);
 
-    if (inCurrentActivity) {
-        views = m_layoutsManager->synchronizer()->viewsBasedOnActivityId(m_activitiesConsumer->currentActivity());
-    } else {
-        views = m_layoutsManager->synchronizer()->viewsBasedOnActivityId(activityid);
+    if (cached != m_availableScreenRegions.constEnd()) {
+        return cached.value();
     }
 
-    if (views.isEmpty()) {
-        return available;
-    }
+    QRegion available = calculateAvailableScreenRegion(key);
+    m_availableScreenRegions.insert(key, available);
 
-    //! blacklist irrelevant visibility modes
-    if (!ignoreModes.contains(Latte::Types::None)) {
-        ignoreModes << Latte::Types::None;
-    }
+    return available;
+}
 
-    if (!ignoreModes.contains(Latte::Types::NormalWindow)) {
-        ignoreModes << Latte::Types::NormalWindow;
-    }
+QRegion Corona::calculateAvailableScreenRegion(const AvailableAreaKey &key) const
+{
+    const QScreen *screen = m_screenPool->screenForId(key.screen);
+    QRegion available = key.ignoreExternalPanels ? screen->geometry() : screen->availableGeometry();
 
-    bool allEdges = ignoreEdges.isEmpty();
+    for (const auto *view : availableAreaViews(key, screen)) {
+        int realThickness = view->normalThickness();
 
-    for (const auto *view : views) {
-        if (view && view->containment() && view->screen() == screen
-                && ((allEdges || !ignoreEdges.contains(view->location()))
-                    && (view->visibility() && !ignoreModes.contains(view->visibility()->mode())))) {
-            int realThickness = view->normalThickness();
-
-            int x = 0; int y = 0; int w = 0; int h = 0;
-
-            switch (view->formFactor()) {
-            case Plasma::Types::Horizontal:
-                if (view->behaveAsPlasmaPanel()) {
-                    w = view->width();
-                    x = view->x();
-                } else {
-                    w = view->maxLength() * view->width();
-                    int offsetW = view->offset() * view->width();
-
-                    switch (view->alignment()) {
-                    case Latte::Types::Left:
-                        x = view->x() + offsetW;
-                        break;
-
-                    case Latte::Types::Center:
-                    case Latte::Types::Justify:
-                        x = (view->geometry().center().x() - w/2) + offsetW;
-                        break;
-
-                    case Latte::Types::Right:
-                        x = view->geometry().right() - w - offsetW;
-                        break;
-                    }
+        int x = 0; int y = 0; int w = 0; int h = 0;
+
+        switch (view->formFactor()) {
+        case Plasma::Types::Horizontal:
+            if (view->behaveAsPlasmaPanel()) {
+                w = view->width();
+                x = view->x();
+            } else {
+                w = view->maxLength() * view->width();
+                int offsetW = view->offset() * view->width();
+
+                switch (view->alignment()) {
+                case Latte::Types::Left:
+                    x = view->x() + offsetW;
+                    break;
+
+                case Latte::Types::Center:
+                case Latte::Types::Justify:
+                    x = (view->geometry().center().x() - w/2) + offsetW;
+                    break;
+
+                case Latte::Types::Right:
+                    x = view->geometry().right() - w - offsetW;
+                    break;
                 }
-                break;
-            case Plasma::Types::Vertical:
-                if (view->behaveAsPlasmaPanel()) {
-                    h = view->height();
-                    y = view->y();
-                } else {
-                    h = view->maxLength() * view->height();
-                    int offsetH = view->offset() * view->height();
-
-                    switch (view->alignment()) {
-                    case Latte::Types::Top:
-                        y = view->y() + offsetH;
-                        break;
-
-                    case Latte::Types::Center:
-                    case Latte::Types::Justify:
-                        y = (view->geometry().center().y() - h/2) + offsetH;
-                        break;
-
-                    case Latte::Types::Bottom:
-                        y = view->geometry().bottom() - h - offsetH;
-                        break;
-                    }
+            }
+            break;
+        case Plasma::Types::Vertical:
+            if (view->behaveAsPlasmaPanel()) {
+                h = view->height();
+                y = view->y();
+            } else {
+                h = view->maxLength() * view->height();
+                int offsetH = view->offset() * view->height();
+
+                switch (view->alignment()) {
+                case Latte::Types::Top:
+                    y = view->y() + offsetH;
+                    break;
+
+                case Latte::Types::Center:
+                case Latte::Types::Justify:
+                    y = (view->geometry().center().y() - h/2) + offsetH;
+                    break;
+
+                case Latte::Types::Bottom:
+                    y = view->geometry().bottom() - h - offsetH;
+                    break;
                 }
-                break;
             }
+            break;
+        }
 
-            // Usually availableScreenRect is used by the desktop,
-            // but Latte don't have desktop, then here just
-            // need calculate available space for top and bottom location,
-            // because the left and right are those who dodge others views
-            switch (view->location()) {
-            case Plasma::Types::TopEdge:
-                if (view->behaveAsPlasmaPanel()) {
-                    QRect viewGeometry = view->geometry();
-
-                    if (desktopUse) {
-                        //! ignore any real window slide outs in all cases
-                        viewGeometry.moveTop(view->screen()->geometry().top() + view->screenEdgeMargin());
-                    }
+        // Usually availableScreenRect is used by the desktop,
+        // but Latte don't have desktop, then here just
+        // need calculate available space for top and bottom location,
+        // because the left and right are those who dodge others views
+        switch (view->location()) {
+        case Plasma::Types::TopEdge:
+            if (view->behaveAsPlasmaPanel()) {
+                QRect viewGeometry = view->geometry();
 
-                    available -= viewGeometry;
-                } else {                  
-                    y = view->y();
-                    available -= QRect(x, y, w, realThickness);
+                if (key.desktopUse) {
+                    //! ignore any real window slide outs in all cases
+                    viewGeometry.moveTop(view->screen()->geometry().top() + view->screenEdgeMargin());
                 }
 
-                break;
+                available -= viewGeometry;
+            } else {                  
+                y = view->y();
+                available -= QRect(x, y, w, realThickness);
+            }
 
-            case Plasma::Types::BottomEdge:
-                if (view->behaveAsPlasmaPanel()) {
-                    QRect viewGeometry = view->geometry();
+            break;
 
-                    if (desktopUse) {
-                        //! ignore any real window slide outs in all cases
-                        viewGeometry.moveTop(view->screen()->geometry().bottom() - view->screenEdgeMargin() - viewGeometry.height());
-                    }
+        case Plasma::Types::BottomEdge:
+            if (view->behaveAsPlasmaPanel()) {
+                QRect viewGeometry = view->geometry();
 
-                    available -= viewGeometry;
-                } else {
-                    y = view->geometry().bottom() - realThickness + 1;
-                    available -= QRect(x, y, w, realThickness);
+                if (key.desktopUse) {
+                    //! ignore any real window slide outs in all cases
+                    viewGeometry.moveTop(view->screen()->geometry().bottom() - view->screenEdgeMargin() - viewGeometry.height());
                 }
 
-                break;
+                available -= viewGeometry;
+            } else {
+                y = view->geometry().bottom() - realThickness + 1;
+                available -= QRect(x, y, w, realThickness);
+            }
 
-            case Plasma::Types::LeftEdge:
-                if (view->behaveAsPlasmaPanel()) {
-                    QRect viewGeometry = view->geometry();
+            break;
 
-                    if (desktopUse) {
-                        //! ignore any real window slide outs in all cases
-                        viewGeometry.moveLeft(view->screen()->geometry().left() + view->screenEdgeMargin());
-                    }
+        case Plasma::Types::LeftEdge:
+            if (view->behaveAsPlasmaPanel()) {
+                QRect viewGeometry = view->geometry();
 
-                    available -= viewGeometry;
-                } else {
-                    x = view->x();
-                    available -= QRect(x, y, realThickness, h);
+                if (key.desktopUse) {
+                    //! ignore any real window slide outs in all cases
+                    viewGeometry.moveLeft(view->screen()->geometry().left() + view->screenEdgeMargin());
                 }
 
-                break;
+                available -= viewGeometry;
+            } else {
+                x = view->x();
+                available -= QRect(x, y, realThickness, h);
+            }
 
-            case Plasma::Types::RightEdge:
-                if (view->behaveAsPlasmaPanel()) {
-                    QRect viewGeometry = view->geometry();
+            break;
 
-                    if (desktopUse) {
-                        //! ignore any real window slide outs in all cases
-                        viewGeometry.moveLeft(view->screen()->geometry().right() - view->screenEdgeMargin() - viewGeometry.width());
-                    }
+        case Plasma::Types::RightEdge:
+            if (view->behaveAsPlasmaPanel()) {
+                QRect viewGeometry = view->geometry();
 
-                    available -= viewGeometry;
-                } else {                    
-                    x = view->geometry().right() - realThickness + 1;
-                    available -= QRect(x, y, realThickness, h);
+                if (key.desktopUse) {
+                    //! ignore any real window slide outs in all cases
+                    viewGeometry.moveLeft(view->screen()->geometry().right() - view->screenEdgeMargin() - viewGeometry.width());
                 }
 
-                break;
-
-            default:
-                //! bypass clang warnings
-                break;
+                available -= viewGeometry;
+            } else {                    
+                x = view->geometry().right() - realThickness + 1;
+                available -= QRect(x, y, realThickness, h);
             }
+
+            break;
+
+        default:
+            //! bypass clang warnings
+            break;
         }
     }
 
@@ -732,90 +790,76 @@ QRect Corona::availableScreenRectWithCriteria(int id,
                                               bool ignoreExternalPanels,
                                               bool desktopUse) const
 {
-    const QScreen *screen = m_screenPool->screenForId(id);
-    bool inCurrentActivity{activityid.isEmpty()};
+    const AvailableAreaKey key = availableAreaKey(id, activityid, ignoreModes, ignoreEdges, ignoreExternalPanels, desktopUse);
 
-    if (!screen) {
+    if (key.screen < 0) {
         return {};
     }
 
-    QRect available = ignoreExternalPanels ? screen->geometry() : screen->availableGeometry();
-
-    QList<Latte::View *> views;
-
-    if (inCurrentActivity) {
-        views = m_layoutsManager->synchronizer()->viewsBasedOnActivityId(m_activitiesConsumer->currentActivity());
-    } else {
-        views = m_layoutsManager->synchronizer()->viewsBasedOnActivityId(activityid);
-    }
-
-    if (views.isEmpty()) {
-        return available;
-    }
-
-    //! blacklist irrelevant visibility modes
-    if (!ignoreModes.contains(Latte::Types::None)) {
-        ignoreModes << Latte::Types::None;
-    }
+    auto cached = m_availableScreenRects.constFind(key);
 
-    if (!ignoreModes.contains(Latte::Types::NormalWindow)) {
-        ignoreModes << Latte::Types::NormalWindow;
+    if (cached != m_availableScreenRects.constEnd()) {
+        return cached.value();
     }
 
-    bool allEdges = ignoreEdges.isEmpty();
+    QRect available = calculateAvailableScreenRect(key);
+    m_availableScreenRects.insert(key, available);
 
-    for (const auto *view : views) {
-        if (view && view->containment() && view->screen() == screen
-                && ((allEdges || !ignoreEdges.contains(view->location()))
-                    && (view->visibility() && !ignoreModes.contains(view->visibility()->mode())))) {
-
-            int appliedThickness = view->behaveAsPlasmaPanel() ? view->screenEdgeMargin() + view->normalThickness() : view->normalThickness();
-
-            // Usually availableScreenRect is used by the desktop,
-            // but Latte don't have desktop, then here just
-            // need calculate available space for top and bottom location,
-            // because the left and right are those who dodge others docks
-            switch (view->location()) {
-            case Plasma::Types::TopEdge:
-                if (view->behaveAsPlasmaPanel() && desktopUse) {
-                    //! ignore any real window slide outs in all cases
-                    available.setTop(qMax(available.top(), view->screen()->geometry().top() + appliedThickness));
-                } else {
-                    available.setTop(qMax(available.top(), view->y() + appliedThickness));
-                }
-                break;
+    return available;
+}
 
-            case Plasma::Types::BottomEdge:
-                if (view->behaveAsPlasmaPanel() && desktopUse) {
-                    //! ignore any real window slide outs in all cases
-                    available.setBottom(qMin(available.bottom(), view->screen()->geometry().bottom() - appliedThickness));
-                } else {
-                    available.setBottom(qMin(available.bottom(), view->y() + view->height() - appliedThickness));
-                }
-                break;
+QRect Corona::calculateAvailableScreenRect(const AvailableAreaKey &key) const
+{
+    const QScreen *screen = m_screenPool->screenForId(key.screen);
+    QRect available = key.ignoreExternalPanels ? screen->geometry() : screen->availableGeometry();
+
+    for (const auto *view : availableAreaViews(key, screen)) {
+        int appliedThickness = view->behaveAsPlasmaPanel() ? view->screenEdgeMargin() + view->normalThickness() : view->normalThickness();
+
+        // Usually availableScreenRect is used by the desktop,
+        // but Latte don't have desktop, then here just
+        // need calculate available space for top and bottom location,
+        // because the left and right are those who dodge others docks
+        switch (view->location()) {
+        case Plasma::Types::TopEdge:
+            if (view->behaveAsPlasmaPanel() && key.desktopUse) {
+                //! ignore any real window slide outs in all cases
+                available.setTop(qMax(available.top(), view->screen()->geometry().top() + appliedThickness));
+            } else {
+                available.setTop(qMax(available.top(), view->y() + appliedThickness));
+            }
+            break;
 
-            case Plasma::Types::LeftEdge:
-                if (view->behaveAsPlasmaPanel() && desktopUse) {
-                    //! ignore any real window slide outs in all cases
-                    available.setLeft(qMax(available.left(), view->screen()->geometry().left() + appliedThickness));
-                } else {
-                    available.setLeft(qMax(available.left(), view->x() + appliedThickness));
-                }
-                break;
+        case Plasma::Types::BottomEdge:
+            if (view->behaveAsPlasmaPanel() && key.desktopUse) {
+                //! ignore any real window slide outs in all cases
+                available.setBottom(qMin(available.bottom(), view->screen()->geometry().bottom() - appliedThickness));
+            } else {
+                available.setBottom(qMin(available.bottom(), view->y() + view->height() - appliedThickness));
+            }
+            break;
 
-            case Plasma::Types::RightEdge:
-                if (view->behaveAsPlasmaPanel() && desktopUse) {
-                    //! ignore any real window slide outs in all cases
-                    available.setRight(qMin(available.right(), view->screen()->geometry().right() - appliedThickness));
-                } else {
-                    available.setRight(qMin(available.right(), view->x() + view->width() - appliedThickness));
-                }
-                break;
+        case Plasma::Types::LeftEdge:
+            if (view->behaveAsPlasmaPanel() && key.desktopUse) {
+                //! ignore any real window slide outs in all cases
+                available.setLeft(qMax(available.left(), view->screen()->geometry().left() + appliedThickness));
+            } else {
+                available.setLeft(qMax(available.left(), view->x() + appliedThickness));
+            }
+            break;
 
-            default:
-                //! bypass clang warnings
-                break;
+        case Plasma::Types::RightEdge:
+            if (view->behaveAsPlasmaPanel() && key.desktopUse) {
+                //! ignore any real window slide outs in all cases
+                available.setRight(qMin(available.right(), view->screen()->geometry().right() - appliedThickness));
+            } else {
+                available.setRight(qMin(available.right(), view->x() + view->width() - appliedThickness));
             }
+            break;
+
+        default:
+            //! bypass clang warnings
+            break;
         }
     }
 
@@ -835,6 +879,7 @@ void Corona::addOutput(QScreen *screen)
 
     connect(screen, &QScreen::geometryChanged, this, [ = ]() {
         const int id = m_screenPool->id(screen->name());
+        invalidateAvailableScreenAreas();
 
         if (id >= 0) {
             emit screenGeometryChanged(id);
@@ -843,6 +888,9 @@ void Corona::addOutput(QScreen *screen)
         }
     });
 
+    connect(screen, &QScreen::availableGeometryChanged, this, &Corona::invalidateAvailableScreenAreas, Qt::UniqueConnection);
+
+    invalidateAvailableScreenAreas();
     emit availableScreenRectChanged();
     emit screenAdded(m_screenPool->id(screen->name()));
 
@@ -851,16 +899,30 @@ void Corona::addOutput(QScreen *screen)
 
 void Corona::primaryOutputChanged()
 {
-    m_viewsScreenSyncTimer.start();
+    startScreensReconciliation();
 }
 
 void Corona::screenRemoved(QScreen *screen)
 {
+    invalidateAvailableScreenAreas();
     screenCountChanged();
 }
 
 void Corona::screenCountChanged()
 {
+    startScreensReconciliation();
+}
+
+void Corona::startScreensReconciliation()
+{
+    //! consecutive screen events e.g. from a docking station are reconciled together
+    //! and measured from the first one
+    if (!m_screensReconciliationTime.isValid()) {
+        m_screensReconciliationTime.start();
+        m_screensReconciliationEvents = 0;
+    }
+
+    m_screensReconciliationEvents++;
     m_viewsScreenSyncTimer.start();
 }
 
@@ -868,7 +930,21 @@ void Corona::screenCountChanged()
 //! concerning screen changed (for multi-screen setups mainly)
 void Corona::syncLatteViewsToScreens()
 {
+    QElapsedTimer applyTime;
+    applyTime.start();
+
     m_layoutsManager->synchronizer()->syncLatteViewsToScreens();
+
+    if (m_screensReconciliationTime.isValid()) {
+        m_screensReconciliations++;
+        m_lastScreensReconciliationEvents = m_screensReconciliationEvents;
+        m_lastScreensReconciliationTotal = m_screensReconciliationTime.elapsed();
+        m_lastScreensReconciliationApply = applyTime.elapsed();
+        m_maxScreensReconciliationApply = qMax(m_maxScreensReconciliationApply, m_lastScreensReconciliationApply);
+
+        qDebug() << "Screens change reconciled in:" << m_lastScreensReconciliationTotal << "ms, views applied in:" << m_lastScreensReconciliationApply << "ms";
+        m_screensReconciliationTime.invalidate();
+    }
 }
 
 int Corona::primaryScreenId() const
@@ -1219,6 +1295,46 @@ QStringList Corona::contextMenuData()
     return data;
 }
 
+QStringList Corona::windowsTrackerStatistics()
+{
+    return m_wm->windowsTracker()->statistics();
+}
+
+void Corona::resetWindowsTrackerStatistics()
+{
+    m_wm->windowsTracker()->resetStatistics();
+}
+
+QStringList Corona::fileWatcherStatistics()
+{
+    return FileWatcher::self()->statistics();
+}
+
+QStringList Corona::screensReconciliationStatistics()
+{
+    return {QStringLiteral("reconciliations=%1").arg(m_screensReconciliations),
+            QStringLiteral("lastScreenEvents=%1").arg(m_lastScreensReconciliationEvents),
+            QStringLiteral("lastTotalMs=%1").arg(m_lastScreensReconciliationTotal),
+            QStringLiteral("lastApplyMs=%1").arg(m_lastScreensReconciliationApply),
+            QStringLiteral("maxApplyMs=%1").arg(m_maxScreensReconciliationApply),
+            QStringLiteral("debounceMs=%1").arg(m_viewsScreenSyncTimer.interval())};
+}
+
+QStringList Corona::viewsStatistics()
+{
+    QStringList entries;
+
+    for (const auto view : m_layoutsManager->synchronizer()->currentViews()) {
+        if (!view->containment()) {
+            continue;
+        }
+
+        entries << QStringLiteral("view.%1.wakeupsPerMinute=%2").arg(view->containment()->id()).arg(view->positioner()->wakeupsPerMinute());
+    }
+
+    return entries;
+}
+
 void Corona::setBackgroundFromBroadcast(QString activity, QString screenName, QString filename)
 {
     if (filename.startsWith("file://")) {
@@ -28,7 +28,11 @@
 #include "view/panelshadows_p.h"
 
 // Qt
+#include <QElapsedTimer>
+#include <QHash>
 #include <QObject>
+#include <QRect>
+#include <QRegion>
 #include <QTimer>
 
 // Plasma
@@ -115,7 +119,8 @@ public:
     //! This is a very generic function in order to return the availableScreenRect of specific screen
     //! by calculating only the user specified visibility modes and edges. Empty QLists for both
     //! arguments mean that all choices are accepted in calculations. ignoreExternalPanels means that
-    //! external panels should be not considered in the calculations
+    //! external panels should be not considered in the calculations. Results are memoized until
+    //! a view footprint, a screen or the layouts of the activities change
     QRect availableScreenRectWithCriteria(int id,
                                           QString activityid = QString(),
                                           QList<Types::Visibility> ignoreModes = QList<Types::Visibility>(),
@@ -162,6 +167,16 @@ public:
     void setContextMenuView(int id);
     QStringList contextMenuData();
 
+    //! windows tracker runtime counters and latency histograms as "key=value" entries
+    QStringList windowsTrackerStatistics();
+    void resetWindowsTrackerStatistics();
+    //! watched configuration paths with their subscribers and changes
+    QStringList fileWatcherStatistics();
+    //! screens hotplug reconciliations timings as "key=value" entries
+    QStringList screensReconciliationStatistics();
+    //! per view runtime counters as "view.<containment id>.<counter>=value" entries
+    QStringList viewsStatistics();
+
 public slots:
     void aboutApplication();
     void addViewForLayout(QString layoutName);
@@ -178,6 +193,9 @@ public slots:
 
     void unload();
 
+    //! drops the memoized available screen rects and regions
+    void invalidateAvailableScreenAreas();
+
 signals:
     void configurationShown(PlasmaQuick::ConfigView *configView);
     void viewLocationChanged();
@@ -197,9 +215,44 @@ private slots:
     void syncLatteViewsToScreens();
 
 private:
+    //! criteria of a memoized available screen rect or region, the visibility modes
+    //! and the edges that are ignored are stored as bitmasks
+    struct AvailableAreaKey {
+        int screen{-1};
+        QString activity;
+        uint ignoredModes{0};
+        uint ignoredEdges{0};
+        bool ignoreExternalPanels{true};
+        bool desktopUse{false};
+
+        bool operator==(const AvailableAreaKey &other) const {
+            return screen == other.screen && activity == other.activity
+                    && ignoredModes == other.ignoredModes && ignoredEdges == other.ignoredEdges
+                    && ignoreExternalPanels == other.ignoreExternalPanels && desktopUse == other.desktopUse;
+        }
+
+        friend uint qHash(const AvailableAreaKey &key, uint seed = 0) {
+            return ::qHash(key.activity, seed)
+                    ^ (uint(key.screen) << 24) ^ (key.ignoredModes << 8) ^ (key.ignoredEdges << 1)
+                    ^ (key.ignoreExternalPanels ? 0x80000000u : 0u) ^ (key.desktopUse ? 1u : 0u);
+        }
+    };
+
+    AvailableAreaKey availableAreaKey(int id,
+                                      const QString &activityid,
+                                      const QList<Types::Visibility> &ignoreModes,
+                                      const QList<Plasma::Types::Location> &ignoreEdges,
+                                      bool ignoreExternalPanels,
+                                      bool desktopUse) const;
+    QList<Latte::View *> availableAreaViews(const AvailableAreaKey &key, const QScreen *screen) const;
+
+    QRect calculateAvailableScreenRect(const AvailableAreaKey &key) const;
+    QRegion calculateAvailableScreenRegion(const AvailableAreaKey &key) const;
+
     void cleanConfig();
     void qmlRegisterTypes() const;
     void setupWaylandIntegration();
+    void startScreensReconciliation();
 
     bool appletExists(uint containmentId, uint appletId) const;
     bool containmentExists(uint id) const;
@@ -229,7 +282,21 @@ private:
 
     QList<KDeclarative::QmlObjectSharedEngine *> m_alternativesObjects;
 
+    mutable QHash<AvailableAreaKey, QRect> m_availableScreenRects;
+    mutable QHash<AvailableAreaKey, QRegion> m_availableScreenRegions;
+
     QTimer m_viewsScreenSyncTimer;
+    //! time since the first screen event that is not reconciled yet
+    QElapsedTimer m_screensReconciliationTime;
+    int m_screensReconciliationEvents{0};
+
+    //! screens reconciliations statistics, total times are measured from the first screen
+    //! event and apply times from the debounce expiry
+    int m_screensReconciliations{0};
+    int m_lastScreensReconciliationEvents{0};
+    qint64 m_lastScreensReconciliationTotal{0};
+    qint64 m_lastScreensReconciliationApply{0};
+    qint64 m_maxScreensReconciliationApply{0};
 
     KActivities::Consumer *m_activitiesConsumer;
     QPointer<KAboutApplicationDialog> aboutDialog;
@@ -35,6 +35,7 @@
 // Qt
 #include <QDebug>
 #include <QScreen>
+#include <QSet>
 
 // Plasma
 #include <Plasma>
@@ -119,6 +120,7 @@ void GenericLayout::unloadLatteViews()
              << " ,hidden latteViews in memory :::  " << m_waitingLatteViews.size();
 
     //!disconnect signals in order to avoid crashes when the layout is unloading
+    disconnect(this, &GenericLayout::viewsCountChanged, m_corona, &Latte::Corona::invalidateAvailableScreenAreas);
     disconnect(this, &GenericLayout::viewsCountChanged, m_corona, &Plasma::Corona::availableScreenRectChanged);
     disconnect(this, &GenericLayout::viewsCountChanged, m_corona, &Plasma::Corona::availableScreenRegionChanged);
     disconnect(this, &GenericLayout::activitiesChanged, this, &GenericLayout::updateLastUsedActivity);
@@ -986,7 +988,8 @@ bool GenericLayout::initToCorona(Latte::Corona *corona)
     connect(this, &GenericLayout::lastConfigViewForChanged, m_corona->layoutsManager(), &Layouts::Manager::lastConfigViewChangedFrom);
     connect(m_corona->layoutsManager(), &Layouts::Manager::lastConfigViewChangedFrom, this, &GenericLayout::onLastConfigViewChangedFrom);
 
-    //!connect signals after adding the containment
+    //!connect signals after adding the containment, the memoized areas are invalidated first
+    connect(this, &GenericLayout::viewsCountChanged, m_corona, &Latte::Corona::invalidateAvailableScreenAreas);
     connect(this, &GenericLayout::viewsCountChanged, m_corona, &Plasma::Corona::availableScreenRectChanged);
     connect(this, &GenericLayout::viewsCountChanged, m_corona, &Plasma::Corona::availableScreenRegionChanged);
 
@@ -1332,30 +1335,73 @@ void GenericLayout::syncLatteViewsToScreens(Layout::ViewsMap *occupiedMap)
     qDebug() << "PRIMARY SCREEN :: " << prmScreenName;
     qDebug() << "LATTEVIEWS MAP :: " << viewsMap;
 
-    //! add views
-    for (const auto containment : m_containments) {
-        int screenId = containment->screen();
-
-        if (!Layouts::Storage::isValid(screenId)) {
-            screenId = containment->lastScreen();
-        }
+    //! target screen for each containment that must have a view
+    QHash<uint, QString> targetScreens;
 
-        if (!latteViewExists(containment) && mapContainsId(&viewsMap, containment->id())) {
-            qDebug() << "syncLatteViewsToScreens: view must be added... for containment:" << containment->id() << " at screen:" << m_corona->screenPool()->connector(screenId);
-            addView(containment);
+    for (const QString &screenName : viewsMap.keys()) {
+        for (const Plasma::Types::Location &location : viewsMap[screenName].keys()) {
+            for (const auto id : viewsMap[screenName][location]) {
+                targetScreens[id] = screenName;
+            }
         }
     }
 
-    //! remove views
+    //! diff the target assignment against the current views in order to touch only
+    //! the views that are really affected from the screens change
+    QList<Plasma::Containment *> viewsToAdd;
     QList<Plasma::Containment *> viewsToDelete;
+    QList<Latte::View *> viewsToMove;
+    QList<Latte::View *> viewsUnchanged;
+
+    for (const auto containment : m_containments) {
+        if (!latteViewExists(containment) && targetScreens.contains(containment->id())) {
+            viewsToAdd << containment;
+        }
+    }
 
     for (auto view : m_latteViews) {
         auto containment = view->containment();
-        if (containment && !mapContainsId(&viewsMap, containment->id())) {
+
+        if (!containment) {
+            continue;
+        }
+
+        if (!targetScreens.contains(containment->id())) {
             viewsToDelete << containment;
+        } else {
+            QString targetScreen = targetScreens[containment->id()];
+
+            if (!view->screen() || view->screen()->name() != targetScreen
+                    || view->positioner()->currentScreenName() != targetScreen) {
+                viewsToMove << view;
+            } else {
+                viewsUnchanged << view;
+            }
         }
     }
 
+    //! screens whose available area changes because views are leaving or arriving
+    QSet<QString> affectedScreens;
+
+    for (const auto containment : viewsToDelete) {
+        affectedScreens << m_latteViews[containment]->positioner()->currentScreenName();
+    }
+
+    for (const auto view : viewsToMove) {
+        affectedScreens << view->positioner()->currentScreenName();
+        affectedScreens << targetScreens[view->containment()->id()];
+    }
+
+    for (const auto containment : viewsToAdd) {
+        affectedScreens << targetScreens[containment->id()];
+    }
+
+    qDebug() << "syncLatteViewsToScreens: reconciliation :: add:" << viewsToAdd.count()
+             << " move:" << viewsToMove.count()
+             << " delete:" << viewsToDelete.count()
+             << " unchanged:" << (m_latteViews.count() - viewsToMove.count() - viewsToDelete.count());
+
+    //! remove views first, that way their screen edges are freed for the moved and added ones
     while(!viewsToDelete.isEmpty()) {
         auto containment = viewsToDelete.takeFirst();
         auto view = m_latteViews.take(containment);
@@ -1364,13 +1410,22 @@ void GenericLayout::syncLatteViewsToScreens(Layout::ViewsMap *occupiedMap)
         view->deleteLater();
     }
 
-    //! reconsider views
-    for (const auto view : m_latteViews) {
-        if (view->containment() && mapContainsId(&viewsMap, view->containment()->id())) {
-            //! if the dock will not be deleted its a very good point to reconsider
-            //! if the screen in which is running is the correct one
-            qDebug() << "syncLatteViewsToScreens: view must consider its screen... for containment:" << view->containment()->id() << " at screen:" << view->positioner()->currentScreenName();
-            view->reconsiderScreen();
+    //! move views
+    for (const auto view : viewsToMove) {
+        qDebug() << "syncLatteViewsToScreens: view must move... for containment:" << view->containment()->id() << " to screen:" << targetScreens[view->containment()->id()];
+        view->reconsiderScreen();
+    }
+
+    //! add views
+    for (const auto containment : viewsToAdd) {
+        qDebug() << "syncLatteViewsToScreens: view must be added... for containment:" << containment->id() << " at screen:" << targetScreens[containment->id()];
+        addView(containment);
+    }
+
+    //! views that stay at their screen must still adjust their geometry to the new free area
+    for (const auto view : viewsUnchanged) {
+        if (affectedScreens.contains(view->positioner()->currentScreenName())) {
+            view->positioner()->syncGeometry();
         }
     }
 
@@ -23,6 +23,7 @@
 #include "apptypes.h"
 #include "lattecorona.h"
 #include "layouts/importer.h"
+#include "settings/universalsettings.h"
 
 // C++
 #include <memory>
@@ -174,6 +175,18 @@ int main(int argc, char **argv)
     filterDebugEventSinkMask.setDescription(QStringLiteral("Show visual indicators for areas of EventsSink."));
     filterDebugEventSinkMask.setFlags(QCommandLineOption::HiddenFromHelp);
     parser.addOption(filterDebugEventSinkMask);
+
+    QCommandLineOption screenPollingOption(QStringList() << QStringLiteral("screen-polling"));
+    screenPollingOption.setDescription(QStringLiteral("Poll periodically the views screens for drivers that do not report screen changes (Only useful to devs)."));
+    screenPollingOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(screenPollingOption);
+
+    QCommandLineOption recordTraceOption(QStringList() << QStringLiteral("record-trace"));
+    recordTraceOption.setDescription(QStringLiteral("Record the window system events in a trace file (Only useful to devs)."));
+    recordTraceOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    recordTraceOption.setValueName(QStringLiteral("trace_file"));
+    parser.addOption(recordTraceOption);
+
     //! END: Hidden options
 
     parser.process(app);
@@ -306,6 +319,14 @@ int main(int argc, char **argv)
     Latte::Corona corona(defaultLayoutOnStartup, layoutNameOnStartup, memoryUsage);
     KDBusService service(KDBusService::Unique);
 
+    //! --screen-polling option, views are created after the layouts have been loaded
+    corona.universalSettings()->setScreenPolling(parser.isSet(QStringLiteral("screen-polling")));
+
+    //! --record-trace option, traces are replayed with the latte-tracereplay tool
+    if (parser.isSet(QStringLiteral("record-trace"))) {
+        corona.wm()->startEventsRecording(parser.value(QStringLiteral("record-trace")));
+    }
+
     return app.exec();
 }
 
@@ -21,6 +21,7 @@
 
 // local
 #include "../../tools/commontools.h"
+#include "../../tools/filewatcher.h"
 
 // Qt
 #include <QDebug>
@@ -35,7 +36,6 @@
 
 // KDE
 #include <KConfigGroup>
-#include <KDirWatch>
 
 #define MAXHASHSIZE 300
 
@@ -58,10 +58,9 @@ BackgroundCache::BackgroundCache(QObject *parent)
 
     qDebug() << "Default Wallpaper path ::: " << m_defaultWallpaperPath;
 
-    KDirWatch::self()->addFile(configFile);
-
-    connect(KDirWatch::self(), &KDirWatch::dirty, this, &BackgroundCache::settingsFileChanged);
-    connect(KDirWatch::self(), &KDirWatch::created, this, &BackgroundCache::settingsFileChanged);
+    FileWatcher::self()->watchFile(configFile, this, [&](const QString &file) {
+        settingsFileChanged(file);
+    });
 
     if (!m_pool) {
         m_pool = new ScreenPool(this);
@@ -65,9 +65,19 @@ ScreenGeometries::~ScreenGeometries()
 
 void ScreenGeometries::init()
 {
-    QDBusInterface plasmaStrutsIface(PLASMASERVICE, "/StrutManager", PLASMASTRUTNAMESPACE, QDBusConnection::sessionBus());
+    //! the struts manager availability is checked asynchronously in order to not block when plasma is busy
+    QDBusMessage message = QDBusMessage::createMethodCall(PLASMASERVICE, "/StrutManager", "org.freedesktop.DBus.Introspectable", "Introspect");
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(message), this);
 
-    if (plasmaStrutsIface.isValid()) {
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, &ScreenGeometries::introspectionFinished);
+}
+
+void ScreenGeometries::introspectionFinished(QDBusPendingCallWatcher *call)
+{
+    QDBusPendingReply<QString> reply = *call;
+    call->deleteLater();
+
+    if (!reply.isError() && reply.value().contains(PLASMASTRUTNAMESPACE)) {
         m_plasmaInterfaceAvailable = true;
 
         qDebug() << " PLASMA STRUTS MANAGER :: is available...";
@@ -105,9 +115,10 @@ void ScreenGeometries::updateGeometries()
         return;
     }
 
-    QDBusInterface plasmaStrutsIface(PLASMASERVICE, "/StrutManager", PLASMASTRUTNAMESPACE, QDBusConnection::sessionBus());
-
-    if (!plasmaStrutsIface.isValid()) {
+    //! geometries are published again only when plasma has answered the previous publish,
+    //! any publish requested meanwhile is superseded by the newest geometries
+    if (m_pendingCalls > 0) {
+        m_publishRequested = true;
         return;
     }
 
@@ -142,13 +153,13 @@ void ScreenGeometries::updateGeometries()
             //! is using a different layout. When the user from Unity is switching to
             //! Music and afterwards to Canvas the desktop elements are not positioned properly
             if (m_forceGeometryBroadcast) {
-                plasmaStrutsIface.call("setAvailableScreenRect", LATTESERVICE, scrName, QRect());
+                publish("setAvailableScreenRect", scrName, QRect());
             }
 
             //! Disable checks because of the workaround concerning plasma desktop behavior
             if (m_forceGeometryBroadcast || (!m_lastAvailableRect.contains(scrName) || m_lastAvailableRect[scrName] != availableRect)) {
                 m_lastAvailableRect[scrName] = availableRect;
-                plasmaStrutsIface.call("setAvailableScreenRect", LATTESERVICE, scrName, availableRect);
+                publish("setAvailableScreenRect", scrName, availableRect);
                 qDebug() << " PLASMA SCREEN GEOMETRIES, AVAILABLE RECT :: " << screen->name() << " : " << availableRect;
             }
 
@@ -165,7 +176,7 @@ void ScreenGeometries::updateGeometries()
                     rects << rect;
                 }
 
-                plasmaStrutsIface.call("setAvailableScreenRegion", LATTESERVICE, scrName, QVariant::fromValue(rects));
+                publish("setAvailableScreenRegion", scrName, QVariant::fromValue(rects));
                 qDebug() << " PLASMA SCREEN GEOMETRIES, AVAILABLE REGION :: " << screen->name() << " : " << availableRegion;
             }
         }
@@ -177,8 +188,8 @@ void ScreenGeometries::updateGeometries()
     for (QString &lastScrName : m_lastScreenNames) {
         if (!screenIsActive(lastScrName)) {
             //! screen became inactive and its geometries could be unpublished
-            plasmaStrutsIface.call("setAvailableScreenRect", LATTESERVICE, lastScrName, QRect());
-            plasmaStrutsIface.call("setAvailableScreenRegion", LATTESERVICE, lastScrName, QVariant::fromValue(QList<QRect>()));
+            publish("setAvailableScreenRect", lastScrName, QRect());
+            publish("setAvailableScreenRegion", lastScrName, QVariant::fromValue(QList<QRect>()));
 
             m_lastAvailableRect.remove(lastScrName);
             m_lastAvailableRegion.remove(lastScrName);
@@ -189,6 +200,34 @@ void ScreenGeometries::updateGeometries()
     m_lastScreenNames = availableScreenNames;
 }
 
+void ScreenGeometries::publish(const QString &method, const QString &screenName, const QVariant &value)
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(PLASMASERVICE, "/StrutManager", PLASMASTRUTNAMESPACE, method);
+    message.setArguments({QString(LATTESERVICE), screenName, value});
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(message), this);
+    m_pendingCalls++;
+
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, method, screenName](QDBusPendingCallWatcher *call) {
+        m_pendingCalls--;
+
+        if (call->isError()) {
+            qDebug() << " PLASMA SCREEN GEOMETRIES, PUBLISH FAILED :: " << method << " : " << screenName << " : " << call->error().message();
+
+            //! the geometries of that screen must be published again
+            m_lastAvailableRect.remove(screenName);
+            m_lastAvailableRegion.remove(screenName);
+        }
+
+        call->deleteLater();
+
+        if (m_pendingCalls == 0 && m_publishRequested) {
+            m_publishRequested = false;
+            updateGeometries();
+        }
+    });
+}
+
 void ScreenGeometries::availableScreenGeometryChangedFrom(Latte::View *origin)
 {
     if (origin && origin->layout() && origin->layout()->isCurrent()) {
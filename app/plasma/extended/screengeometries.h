@@ -28,6 +28,9 @@
 #include <QHash>
 #include <QObject>
 #include <QTimer>
+#include <QVariant>
+
+class QDBusPendingCallWatcher;
 
 
 namespace Latte {
@@ -50,14 +53,22 @@ private slots:
     void availableScreenGeometryChangedFrom(Latte::View *origin);
 
     void init();
+    void introspectionFinished(QDBusPendingCallWatcher *call);
     void updateGeometries();
 
 private slots:
     bool screenIsActive(const QString &screenName) const;
 
+private:
+    void publish(const QString &method, const QString &screenName, const QVariant &value);
+
 private:
     bool m_plasmaInterfaceAvailable{false};
     bool m_forceGeometryBroadcast{false};
+    bool m_publishRequested{false};
+
+    //! publish calls that plasma has not answered yet
+    int m_pendingCalls{0};
 
     //! this is needed in order to avoid too many costly calculations for available screen geometries
     QTimer m_publishTimer;
@@ -19,6 +19,9 @@
 
 #include "screenpool.h"
 
+// local
+#include "../../tools/filewatcher.h"
+
 // Qt
 #include <QDebug>
 #include <QDir>
@@ -27,7 +30,6 @@
 
 // KDE
 #include <KConfigGroup>
-#include <KDirWatch>
 #include <KSharedConfig>
 
 #define PLASMARC "plasmashellrc"
@@ -45,18 +47,8 @@ ScreenPool::ScreenPool(QObject *parent)
 
     QString plasmaSettingsFile = QDir::homePath() + "/.config/" + PLASMARC;
 
-    KDirWatch::self()->addFile(plasmaSettingsFile);
-
-    connect(KDirWatch::self(), &KDirWatch::dirty, this, [ &, plasmaSettingsFile](const QString & path) {
-        if (path == plasmaSettingsFile) {
-            load();
-        }
-    });
-
-    connect(KDirWatch::self(), &KDirWatch::created, this, [ &, plasmaSettingsFile](const QString & path) {
-        if (path == plasmaSettingsFile) {
-            load();
-        }
+    FileWatcher::self()->watchFile(plasmaSettingsFile, this, [&](const QString &) {
+        load();
     });
 }
 
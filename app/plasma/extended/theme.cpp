@@ -27,6 +27,7 @@
 #include "../../view/panelshadows_p.h"
 #include "../../wm/schemecolors.h"
 #include "../../tools/commontools.h"
+#include "../../tools/filewatcher.h"
 
 // Qt
 #include <QDebug>
@@ -35,7 +36,6 @@
 #include <QProcess>
 
 // KDE
-#include <KDirWatch>
 #include <KConfigGroup>
 #include <KSharedConfig>
 
@@ -364,33 +364,20 @@ void Theme::loadThemePaths()
     qDebug() << "theme path ::: " << m_themePath;
     qDebug() << "theme widgets path ::: " << m_themeWidgetsPath;
 
-    //! clear kde connections
-    for (auto &c : m_kdeConnections) {
-        disconnect(c);
-    }
-
     //! assign color schemes
     QString themeColorScheme = m_themePath + "/colors";
+    QString kdeSettingsFile = QDir::homePath() + "/.config/kdeglobals";
+
+    //! clear kde tracking
+    FileWatcher::self()->unwatch(kdeSettingsFile, this);
 
     if (QFileInfo(themeColorScheme).exists()) {
         setOriginalSchemeFile(themeColorScheme);
     } else {
         //! when plasma theme uses the kde colors
         //! we track when kde color scheme is changing
-        QString kdeSettingsFile = QDir::homePath() + "/.config/kdeglobals";
-
-        KDirWatch::self()->addFile(kdeSettingsFile);
-
-        m_kdeConnections[0] = connect(KDirWatch::self(), &KDirWatch::dirty, this, [ &, kdeSettingsFile](const QString & path) {
-            if (path == kdeSettingsFile) {
-                this->setOriginalSchemeFile(WindowSystem::SchemeColors::possibleSchemeFile("kdeglobals"));
-            }
-        });
-
-        m_kdeConnections[1] = connect(KDirWatch::self(), &KDirWatch::created, this, [ &, kdeSettingsFile](const QString & path) {
-            if (path == kdeSettingsFile) {
-                this->setOriginalSchemeFile(WindowSystem::SchemeColors::possibleSchemeFile("kdeglobals"));
-            }
+        FileWatcher::self()->watchFile(kdeSettingsFile, this, [&](const QString &) {
+            setOriginalSchemeFile(WindowSystem::SchemeColors::possibleSchemeFile("kdeglobals"));
         });
 
         setOriginalSchemeFile(WindowSystem::SchemeColors::possibleSchemeFile("kdeglobals"));
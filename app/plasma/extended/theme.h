@@ -21,9 +21,6 @@
 #ifndef PLASMATHEMEEXTENDED_H
 #define PLASMATHEMEEXTENDED_H
 
-// C++
-#include <array>
-
 // Qt
 #include <QObject>
 #include <QHash>
@@ -143,8 +140,6 @@ private:
 
     QHash<int, CornerRegions> m_cornerRegions;
 
-    std::array<QMetaObject::Connection, 2> m_kdeConnections;
-
     QTemporaryDir m_extendedThemeDir;
     KConfigGroup m_themeGroup;
     Plasma::Theme m_theme;
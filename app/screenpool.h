@@ -26,7 +26,6 @@
 #include <QScreen>
 #include <QString>
 #include <QTimer>
-#include <QAbstractNativeEventFilter>
 
 // KDE
 #include <KConfigGroup>
@@ -34,7 +33,7 @@
 
 namespace Latte {
 
-class ScreenPool : public QObject, public QAbstractNativeEventFilter
+class ScreenPool : public QObject
 {
     Q_OBJECT
 
@@ -69,11 +68,9 @@ public:
 signals:
     void primaryPoolChanged();
 
-protected:
-    bool nativeEventFilter(const QByteArray &eventType, void *message, long *result) Q_DECL_OVERRIDE;
-
 private:
     void save();
+    void updatePrimaryConnector();
 
     KConfigGroup m_configGroup;
     QString m_primaryConnector;
@@ -25,6 +25,7 @@
 #include "../layout/centrallayout.h"
 #include "../layouts/importer.h"
 #include "../layouts/manager.h"
+#include "../tools/filewatcher.h"
 
 // Qt
 #include <QDebug>
@@ -34,7 +35,6 @@
 
 // KDE
 #include <KActivities/Consumer>
-#include <KDirWatch>
 
 #define KWINMETAFORWARDTOLATTESTRING "org.kde.lattedock,/Latte,org.kde.LatteDock,activateLauncherMenu"
 #define KWINMETAFORWARDTOPLASMASTRING "org.kde.plasmashell,/PlasmaShell,org.kde.PlasmaShell,activateLauncherMenu"
@@ -97,22 +97,22 @@ void UniversalSettings::load()
 
     QStringList colorsScriptPaths = Layouts::Importer::standardPathsFor(KWINCOLORSSCRIPT);
     for(auto path: colorsScriptPaths) {
-        KDirWatch::self()->addDir(path);
+        FileWatcher::self()->watchDir(path, this, [&](const QString &file) {
+            trackedFileChanged(file);
+        }, FileWatcher::AnyChange);
     }
 
     //! Track KWin rc options
     const QString kwinrcFilePath = QDir::homePath() + KWINRC;
-    KDirWatch::self()->addFile(kwinrcFilePath);
+    FileWatcher::self()->watchFile(kwinrcFilePath, this, [&](const QString &file) {
+        trackedFileChanged(file);
+    }, FileWatcher::AnyChange);
     recoverKWinOptions();
 
     m_kwinrcTrackerTimer.setSingleShot(true);
     m_kwinrcTrackerTimer.setInterval(KWINRCTRACKERINTERVAL);
     connect(&m_kwinrcTrackerTimer, &QTimer::timeout, this, &UniversalSettings::recoverKWinOptions);
 
-    connect(KDirWatch::self(), &KDirWatch::created, this, &UniversalSettings::trackedFileChanged);
-    connect(KDirWatch::self(), &KDirWatch::deleted, this, &UniversalSettings::trackedFileChanged);
-    connect(KDirWatch::self(), &KDirWatch::dirty, this, &UniversalSettings::trackedFileChanged);
-
     //! this is needed to inform globalshortcuts to update its modifiers tracking
     emit metaPressAndHoldEnabledChanged();
 }
@@ -179,6 +179,21 @@ void UniversalSettings::setScreenTrackerInterval(int duration)
     emit screenTrackerIntervalChanged();
 }
 
+bool UniversalSettings::screenPolling() const
+{
+    return m_screenPolling;
+}
+
+void UniversalSettings::setScreenPolling(bool enabled)
+{
+    if (m_screenPolling == enabled) {
+        return;
+    }
+
+    m_screenPolling = enabled;
+    emit screenPollingChanged();
+}
+
 QString UniversalSettings::singleModeLayoutName() const
 {
     return m_singleModeLayoutName;
@@ -106,6 +106,10 @@ public:
     int screenTrackerInterval() const;
     void setScreenTrackerInterval(int duration);
 
+    //! it is set only from --screen-polling and it is not saved
+    bool screenPolling() const;
+    void setScreenPolling(bool enabled);
+
     QString singleModeLayoutName() const;
     void setSingleModeLayoutName(QString layoutName);
 
@@ -146,6 +150,7 @@ signals:
     void screensCountChanged();
     void screenScalesChanged();
     void screenTrackerIntervalChanged();
+    void screenPollingChanged();
     void showInfoWindowChanged();
     void singleModeLayoutNameChanged();
     void versionChanged();
@@ -186,6 +191,8 @@ private:
 
     int m_screenTrackerInterval{2500};
 
+    bool m_screenPolling{false};
+
     QString m_singleModeLayoutName;
 
     QStringList m_launchers;
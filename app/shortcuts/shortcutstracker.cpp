@@ -19,6 +19,7 @@
 
 // local
 #include "shortcutstracker.h"
+#include "../tools/filewatcher.h"
 
 // Qt
 #include <QAction>
@@ -27,7 +28,6 @@
 
 // KDE
 #include <KConfigGroup>
-#include <KDirWatch>
 #include <KGlobalAccel>
 
 
@@ -59,10 +59,9 @@ void ShortcutsTracker::initGlobalShortcutsWatcher()
     const QString globalShortcutsFilePath = QDir::homePath() + "/.config/" + GLOBALSHORTCUTSCONFIG;
     m_shortcutsConfigPtr = KSharedConfig::openConfig(globalShortcutsFilePath);
 
-    KDirWatch::self()->addFile(globalShortcutsFilePath);
-
-    connect(KDirWatch::self(), &KDirWatch::dirty, this, &ShortcutsTracker::shortcutsFileChanged, Qt::QueuedConnection);
-    connect(KDirWatch::self(), &KDirWatch::created, this, &ShortcutsTracker::shortcutsFileChanged, Qt::QueuedConnection);
+    FileWatcher::self()->watchFile(globalShortcutsFilePath, this, [&](const QString &file) {
+        shortcutsFileChanged(file);
+    });
 }
 
 bool ShortcutsTracker::basedOnPositionEnabled() const
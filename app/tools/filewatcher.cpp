@@ -0,0 +1,216 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filewatcher.h"
+
+// Qt
+#include <QDir>
+
+// KDE
+#include <KDirWatch>
+
+namespace Latte {
+
+//! changes of the same path that arrive within that interval are delivered once
+const int DISPATCHINTERVAL = 100;
+
+FileWatcher::FileWatcher(QObject *parent)
+    : QObject(parent)
+{
+    m_dispatchTimer.setSingleShot(true);
+    m_dispatchTimer.setInterval(DISPATCHINTERVAL);
+    connect(&m_dispatchTimer, &QTimer::timeout, this, &FileWatcher::dispatchChanges);
+
+    connect(KDirWatch::self(), &KDirWatch::dirty, this, [&](const QString &path) {
+        pathChanged(path, DirtyChange);
+    });
+
+    connect(KDirWatch::self(), &KDirWatch::created, this, [&](const QString &path) {
+        pathChanged(path, CreatedChange);
+    });
+
+    connect(KDirWatch::self(), &KDirWatch::deleted, this, [&](const QString &path) {
+        pathChanged(path, DeletedChange);
+    });
+}
+
+FileWatcher::~FileWatcher()
+{
+    m_dispatchTimer.stop();
+}
+
+FileWatcher *FileWatcher::self()
+{
+    static FileWatcher watcher;
+    return &watcher;
+}
+
+void FileWatcher::watchFile(const QString &path, QObject *receiver, const Callback &callback, Changes changes)
+{
+    watch(path, false, receiver, callback, changes);
+}
+
+void FileWatcher::watchDir(const QString &path, QObject *receiver, const Callback &callback, Changes changes)
+{
+    watch(path, true, receiver, callback, changes);
+}
+
+void FileWatcher::watch(const QString &path, bool isDir, QObject *receiver, const Callback &callback, Changes changes)
+{
+    if (path.isEmpty() || !receiver) {
+        return;
+    }
+
+    QString cleanPath = QDir::cleanPath(path);
+
+    if (!m_paths.contains(cleanPath)) {
+        if (isDir) {
+            KDirWatch::self()->addDir(cleanPath);
+        } else {
+            KDirWatch::self()->addFile(cleanPath);
+        }
+
+        m_paths[cleanPath].isDir = isDir;
+    }
+
+    Subscription subscription;
+    subscription.receiver = receiver;
+    subscription.changes = changes;
+    subscription.callback = callback;
+
+    m_paths[cleanPath].subscriptions << subscription;
+
+    if (!m_receivers.contains(receiver)) {
+        m_receivers << receiver;
+        connect(receiver, &QObject::destroyed, this, &FileWatcher::unwatchAll);
+    }
+}
+
+void FileWatcher::unwatch(const QString &path, QObject *receiver)
+{
+    QString cleanPath = QDir::cleanPath(path);
+
+    if (!m_paths.contains(cleanPath)) {
+        return;
+    }
+
+    WatchedPath &watched = m_paths[cleanPath];
+
+    for (int i=watched.subscriptions.count()-1; i>=0; --i) {
+        if (watched.subscriptions[i].receiver == receiver) {
+            watched.subscriptions.removeAt(i);
+        }
+    }
+
+    if (watched.subscriptions.isEmpty()) {
+        if (watched.isDir) {
+            KDirWatch::self()->removeDir(cleanPath);
+        } else {
+            KDirWatch::self()->removeFile(cleanPath);
+        }
+
+        m_paths.remove(cleanPath);
+        m_pendingChanges.remove(cleanPath);
+    }
+}
+
+void FileWatcher::unwatchAll(QObject *receiver)
+{
+    if (!m_receivers.contains(receiver)) {
+        return;
+    }
+
+    m_receivers.remove(receiver);
+
+    //! destroyed receivers are already partially destructed, only their address is used
+    disconnect(receiver, &QObject::destroyed, this, &FileWatcher::unwatchAll);
+
+    for (const auto &path : m_paths.keys()) {
+        unwatch(path, receiver);
+    }
+}
+
+void FileWatcher::pathChanged(const QString &path, const Change &change)
+{
+    QString cleanPath = QDir::cleanPath(path);
+
+    if (!m_paths.contains(cleanPath)) {
+        return;
+    }
+
+    WatchedPath &watched = m_paths[cleanPath];
+    watched.receivedChanges++;
+
+    if (m_pendingChanges.contains(cleanPath)) {
+        watched.mergedChanges++;
+    }
+
+    m_pendingChanges[cleanPath] |= change;
+
+    if (!m_dispatchTimer.isActive()) {
+        m_dispatchTimer.start();
+    }
+}
+
+void FileWatcher::dispatchChanges()
+{
+    //! callbacks can subscribe or unsubscribe paths and receivers
+    QHash<QString, Changes> pendingChanges = m_pendingChanges;
+    m_pendingChanges.clear();
+
+    for (auto it = pendingChanges.constBegin(); it != pendingChanges.constEnd(); ++it) {
+        if (!m_paths.contains(it.key())) {
+            continue;
+        }
+
+        QList<Subscription> subscriptions = m_paths[it.key()].subscriptions;
+
+        for (const auto &subscription : subscriptions) {
+            if (!(subscription.changes & it.value()) || !m_receivers.contains(subscription.receiver)) {
+                continue;
+            }
+
+            if (m_paths.contains(it.key())) {
+                m_paths[it.key()].dispatchedChanges++;
+            }
+
+            subscription.callback(it.key());
+        }
+    }
+}
+
+QStringList FileWatcher::statistics() const
+{
+    QStringList entries;
+
+    for (auto it = m_paths.constBegin(); it != m_paths.constEnd(); ++it) {
+        entries << QStringLiteral("%1 subscribers=%2 received=%3 merged=%4 dispatched=%5")
+                   .arg(it.key())
+                   .arg(it.value().subscriptions.count())
+                   .arg(it.value().receivedChanges)
+                   .arg(it.value().mergedChanges)
+                   .arg(it.value().dispatchedChanges);
+    }
+
+    entries.sort();
+    return entries;
+}
+
+}
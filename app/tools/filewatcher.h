@@ -0,0 +1,108 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+// C++
+#include <functional>
+
+// Qt
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+namespace Latte {
+
+//! Single dispatcher of KDirWatch changes. Subscribers are informed only for the paths
+//! they are interested in and bursts of changes for the same path, e.g. from editors
+//! and KConfig sync() calls, are delivered once
+class FileWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Change
+    {
+        NoChange = 0x00,
+        DirtyChange = 0x01,
+        CreatedChange = 0x02,
+        DeletedChange = 0x04,
+        AnyChange = DirtyChange | CreatedChange | DeletedChange
+    };
+    Q_DECLARE_FLAGS(Changes, Change)
+
+    using Callback = std::function<void(const QString &path)>;
+
+    static FileWatcher *self();
+    ~FileWatcher() override;
+
+    //! subscriptions are removed automatically when their receiver is destroyed
+    void watchFile(const QString &path, QObject *receiver, const Callback &callback, Changes changes = DirtyChange | CreatedChange);
+    void watchDir(const QString &path, QObject *receiver, const Callback &callback, Changes changes = DirtyChange);
+
+    void unwatch(const QString &path, QObject *receiver);
+    void unwatchAll(QObject *receiver);
+
+    //! per path subscribers, received, merged and dispatched changes
+    QStringList statistics() const;
+
+private slots:
+    void dispatchChanges();
+
+private:
+    FileWatcher(QObject *parent = nullptr);
+
+    void watch(const QString &path, bool isDir, QObject *receiver, const Callback &callback, Changes changes);
+    void pathChanged(const QString &path, const Change &change);
+
+private:
+    struct Subscription
+    {
+        QObject *receiver{nullptr};
+        Changes changes{NoChange};
+        Callback callback;
+    };
+
+    struct WatchedPath
+    {
+        bool isDir{false};
+        int receivedChanges{0};
+        int mergedChanges{0};
+        int dispatchedChanges{0};
+        QList<Subscription> subscriptions;
+    };
+
+    QHash<QString, WatchedPath> m_paths;
+    QHash<QString, Changes> m_pendingChanges;
+    QSet<QObject *> m_receivers;
+
+    QTimer m_dispatchTimer;
+};
+
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(Latte::FileWatcher::Changes)
+
+#endif
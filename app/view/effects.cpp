@@ -22,6 +22,7 @@
 // local
 #include <config-latte.h>
 #include <coretypes.h>
+#include "geometrytransaction.h"
 #include "panelshadows_p.h"
 #include "view.h"
 #include "../lattecorona.h"
@@ -31,7 +32,6 @@
 #include <QRegion>
 
 // KDE
-#include <KWindowEffects>
 #include <KWindowSystem>
 
 
@@ -316,13 +316,7 @@ void Effects::setInputMask(QRect area)
     }
 
     m_inputMask = area;
-
-    if (KWindowSystem::isPlatformX11()) {
-        m_corona->wm()->setInputMask(m_view, area);
-    } else {
-        //under wayland mask() is providing the Input Area
-        m_view->setMask(area);
-    }
+    m_view->geometryTransaction()->setInputMask(area);
 
     emit inputMaskChanged();
 }
@@ -442,9 +436,12 @@ void Effects::updateBackgroundCorners()
 
 void Effects::updateMask()
 {
+    //! the window may have a resize that is not committed yet
+    QSize windowSize = m_view->geometryTransaction()->size();
+
     if (KWindowSystem::compositingActive()) {
         if (KWindowSystem::isPlatformX11()) {
-            m_view->setMask(QRect(0, 0, m_view->width(), m_view->height()));
+            m_view->geometryTransaction()->setMask(QRect(QPoint(0, 0), windowSize));
         } else {
             // do nothing
         }
@@ -464,7 +461,7 @@ void Effects::updateMask()
     } else {
         QRegion fixedMask;
 
-        QRect maskRect = m_view->behaveAsPlasmaPanel() ? QRect(0,0, m_view->width(), m_view->height()) : m_mask;
+        QRect maskRect = m_view->behaveAsPlasmaPanel() ? QRect(QPoint(0, 0), windowSize) : m_mask;
 
         if (m_backgroundRadiusEnabled) {
             //! CustomBackground way
@@ -500,7 +497,7 @@ void Effects::updateMask()
             fixedMask = QRegion(maskRect);
         }
 
-        m_view->setMask(fixedMask);
+        m_view->geometryTransaction()->setMask(fixedMask);
     }
 }
 
@@ -526,7 +523,11 @@ void Effects::updateEffects()
         return;
     }
 
-    bool clearEffects{true};
+    ViewPart::GeometryTransaction::BackgroundEffects backgroundEffects;
+    backgroundEffects.contrastEnabled = m_theme.backgroundContrastEnabled();
+    backgroundEffects.contrast = m_backEffectContrast;
+    backgroundEffects.intensity = m_backEffectIntesity;
+    backgroundEffects.saturation = m_backEffectSaturation;
 
     if (m_drawEffects) {
         if (!m_view->behaveAsPlasmaPanel()) {
@@ -586,32 +587,17 @@ void Effects::updateEffects()
                 }
 
                 if (!fixedMask.isEmpty()) {
-                    clearEffects = false;
-                    KWindowEffects::enableBlurBehind(m_view->winId(), true, fixedMask);
-                    KWindowEffects::enableBackgroundContrast(m_view->winId(),
-                                                             m_theme.backgroundContrastEnabled(),
-                                                             m_backEffectContrast,
-                                                             m_backEffectIntesity,
-                                                             m_backEffectSaturation,
-                                                             fixedMask);
+                    backgroundEffects.enabled = true;
+                    backgroundEffects.region = fixedMask;
                 }
             }
         } else {
             //!  BEHAVEASPLASMAPANEL case
-            clearEffects = false;
-            KWindowEffects::enableBlurBehind(m_view->winId(), true);
-            KWindowEffects::enableBackgroundContrast(m_view->winId(),
-                                                     m_theme.backgroundContrastEnabled(),
-                                                     m_backEffectContrast,
-                                                     m_backEffectIntesity,
-                                                     m_backEffectSaturation);
+            backgroundEffects.enabled = true;
         }
     }
 
-    if (clearEffects) {
-        KWindowEffects::enableBlurBehind(m_view->winId(), false);
-        KWindowEffects::enableBackgroundContrast(m_view->winId(), false);
-    }
+    m_view->geometryTransaction()->setBackgroundEffects(backgroundEffects);
 }
 
 //!BEGIN draw panel shadows outside the dock window
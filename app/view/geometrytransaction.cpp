@@ -0,0 +1,220 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "geometrytransaction.h"
+
+// local
+#include "view.h"
+#include "../lattecorona.h"
+#include "../wm/abstractwindowinterface.h"
+
+// KDE
+#include <KWayland/Client/plasmashell.h>
+#include <KWindowEffects>
+#include <KWindowSystem>
+
+namespace Latte {
+namespace ViewPart {
+
+//! one frame at 60Hz
+const int FALLBACKCOMMITINTERVAL = 16;
+
+GeometryTransaction::GeometryTransaction(Latte::View *parent)
+    : QObject(parent),
+      m_view(parent)
+{
+    m_fallbackTimer.setInterval(FALLBACKCOMMITINTERVAL);
+    m_fallbackTimer.setSingleShot(true);
+    connect(&m_fallbackTimer, &QTimer::timeout, this, &GeometryTransaction::commit);
+
+    //! afterAnimating is sent from the GUI thread just before each frame is synchronized
+    connect(m_view, &QQuickWindow::afterAnimating, this, &GeometryTransaction::onFrameAnimated);
+}
+
+GeometryTransaction::~GeometryTransaction()
+{
+    m_fallbackTimer.stop();
+}
+
+QSize GeometryTransaction::size() const
+{
+    return (m_pendingChanges & SizeChange) ? m_size : m_view->size();
+}
+
+QPoint GeometryTransaction::position() const
+{
+    return (m_pendingChanges & PositionChange) ? m_position : m_view->position();
+}
+
+int GeometryTransaction::requests() const
+{
+    return m_requests;
+}
+
+int GeometryTransaction::commits() const
+{
+    return m_commits;
+}
+
+void GeometryTransaction::setSize(const QSize &size)
+{
+    m_size = size;
+    schedule(SizeChange);
+}
+
+void GeometryTransaction::setPosition(const QPoint &position)
+{
+    m_position = position;
+    schedule(PositionChange);
+}
+
+void GeometryTransaction::setMask(const QRegion &mask)
+{
+    m_mask = mask;
+    schedule(MaskChange);
+}
+
+void GeometryTransaction::setInputMask(const QRect &inputMask)
+{
+    m_inputMask = inputMask;
+    schedule(InputMaskChange);
+}
+
+void GeometryTransaction::setFrameExtents(const QMargins &extents)
+{
+    m_frameExtents = extents;
+    schedule(FrameExtentsChange);
+}
+
+void GeometryTransaction::setStruts(const QRect &struts, Plasma::Types::Location location)
+{
+    m_struts = struts;
+    m_strutsLocation = location;
+    m_hasStruts = true;
+    schedule(StrutsChange);
+}
+
+void GeometryTransaction::removeStruts()
+{
+    m_struts = QRect();
+    m_hasStruts = false;
+    schedule(StrutsChange);
+}
+
+void GeometryTransaction::setBackgroundEffects(const BackgroundEffects &effects)
+{
+    m_backgroundEffects = effects;
+    schedule(BackgroundEffectsChange);
+}
+
+void GeometryTransaction::schedule(const Change &change)
+{
+    m_requests++;
+
+    if (m_pendingChanges == NoChange) {
+        //! request a frame in order to commit the changes just before it is rendered
+        m_view->update();
+        m_fallbackTimer.start();
+    }
+
+    m_pendingChanges |= change;
+}
+
+void GeometryTransaction::onFrameAnimated()
+{
+    if (m_pendingChanges != NoChange) {
+        commit();
+    }
+}
+
+void GeometryTransaction::commit()
+{
+    m_fallbackTimer.stop();
+
+    if (m_pendingChanges == NoChange || !m_view) {
+        return;
+    }
+
+    //! changes that are requested while committing are applied at the next frame
+    Changes changes = m_pendingChanges;
+    m_pendingChanges = NoChange;
+    m_commits++;
+
+    auto wm = qobject_cast<Latte::Corona *>(m_view->corona())->wm();
+
+    //! geometry must be applied first because masks, struts and effects are relative to it
+    if (changes & SizeChange) {
+        m_view->setMinimumSize(m_size);
+        m_view->setMaximumSize(m_size);
+        m_view->resize(m_size);
+    }
+
+    if (changes & PositionChange) {
+        m_view->setPosition(m_position);
+
+        if (m_view->surface()) {
+            m_view->surface()->setPosition(m_position);
+        }
+    }
+
+    if (changes & MaskChange) {
+        m_view->setMask(m_mask);
+    }
+
+    if (changes & InputMaskChange) {
+        if (KWindowSystem::isPlatformX11()) {
+            wm->setInputMask(m_view, m_inputMask);
+        } else {
+            //under wayland mask() is providing the Input Area
+            m_view->setMask(m_inputMask);
+        }
+    }
+
+    if (changes & FrameExtentsChange) {
+        wm->setFrameExtents(m_view, m_frameExtents);
+    }
+
+    if (changes & StrutsChange) {
+        if (m_hasStruts) {
+            wm->setViewStruts(*m_view, m_struts, m_strutsLocation);
+        } else {
+            wm->removeViewStruts(*m_view);
+        }
+    }
+
+    if (changes & BackgroundEffectsChange) {
+        if (m_backgroundEffects.enabled) {
+            KWindowEffects::enableBlurBehind(m_view->winId(), true, m_backgroundEffects.region);
+            KWindowEffects::enableBackgroundContrast(m_view->winId(),
+                                                     m_backgroundEffects.contrastEnabled,
+                                                     m_backgroundEffects.contrast,
+                                                     m_backgroundEffects.intensity,
+                                                     m_backgroundEffects.saturation,
+                                                     m_backgroundEffects.region);
+        } else {
+            KWindowEffects::enableBlurBehind(m_view->winId(), false);
+            KWindowEffects::enableBackgroundContrast(m_view->winId(), false);
+        }
+    }
+
+    emit committed(changes);
+}
+
+}
+}
@@ -0,0 +1,135 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef VIEWGEOMETRYTRANSACTION_H
+#define VIEWGEOMETRYTRANSACTION_H
+
+// Qt
+#include <QMargins>
+#include <QObject>
+#include <QPoint>
+#include <QPointer>
+#include <QRect>
+#include <QRegion>
+#include <QSize>
+#include <QTimer>
+
+// Plasma
+#include <Plasma>
+
+namespace Latte {
+class View;
+}
+
+namespace Latte {
+namespace ViewPart {
+
+//! Collects the window level changes of a view, e.g. geometry, masks, struts and background
+//! effects, and applies them together once per frame in a defined order. This way location
+//! changes and screen hotplugs do not trigger a compositor round trip for each one of them
+class GeometryTransaction: public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Change
+    {
+        NoChange = 0x00,
+        SizeChange = 0x01,
+        PositionChange = 0x02,
+        MaskChange = 0x04,
+        InputMaskChange = 0x08,
+        FrameExtentsChange = 0x10,
+        StrutsChange = 0x20,
+        BackgroundEffectsChange = 0x40
+    };
+    Q_DECLARE_FLAGS(Changes, Change)
+
+    struct BackgroundEffects
+    {
+        bool enabled{false};
+        bool contrastEnabled{false};
+        qreal contrast{1};
+        qreal intensity{1};
+        qreal saturation{1};
+        //! an empty region means the entire window
+        QRegion region;
+    };
+
+    GeometryTransaction(Latte::View *parent);
+    ~GeometryTransaction() override;
+
+    //! the pending values or the window current ones when nothing is pending
+    QSize size() const;
+    QPoint position() const;
+
+    //! raw change requests versus the commits that applied them
+    int requests() const;
+    int commits() const;
+
+    void setSize(const QSize &size);
+    void setPosition(const QPoint &position);
+    void setMask(const QRegion &mask);
+    void setInputMask(const QRect &inputMask);
+    void setFrameExtents(const QMargins &extents);
+    void setStruts(const QRect &struts, Plasma::Types::Location location);
+    void removeStruts();
+    void setBackgroundEffects(const BackgroundEffects &effects);
+
+public slots:
+    void commit();
+
+signals:
+    //! sent after the changes have been applied to the window
+    void committed(Latte::ViewPart::GeometryTransaction::Changes changes);
+
+private slots:
+    void onFrameAnimated();
+
+private:
+    void schedule(const Change &change);
+
+private:
+    Changes m_pendingChanges{NoChange};
+
+    QSize m_size;
+    QPoint m_position;
+    QRegion m_mask;
+    QRect m_inputMask;
+    QMargins m_frameExtents;
+    bool m_hasStruts{false};
+    QRect m_struts;
+    Plasma::Types::Location m_strutsLocation{Plasma::Types::Floating};
+    BackgroundEffects m_backgroundEffects;
+
+    int m_requests{0};
+    int m_commits{0};
+
+    //! commits pending changes when the window does not produce frames, e.g. it is hidden
+    QTimer m_fallbackTimer;
+
+    QPointer<Latte::View> m_view;
+};
+
+}
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(Latte::ViewPart::GeometryTransaction::Changes)
+
+#endif
@@ -22,6 +22,7 @@
 // local
 #include <coretypes.h>
 #include "effects.h"
+#include "geometrytransaction.h"
 #include "view.h"
 #include "visibilitymanager.h"
 #include "../lattecorona.h"
@@ -43,6 +44,11 @@
 namespace Latte {
 namespace ViewPart {
 
+//! corrective syncs that are tried after a window manager misplacement before
+//! giving up until the next screen or geometry event
+const int MAXCORRECTIVESYNCS = 5;
+const int WAKEUPSPERIOD = 60000;
+
 Positioner::Positioner(Latte::View *parent)
     : QObject(parent),
       m_view(parent)
@@ -53,17 +59,39 @@ Positioner::Positioner(Latte::View *parent)
 
     //! under X11 it was identified that windows many times especially under screen changes
     //! don't end up at the correct position and size. This timer will enforce repositionings
-    //! and resizes every 500ms if the window hasn't end up to correct values and until this
-    //! is achieved
+    //! and resizes every 500ms if the window hasn't end up to correct values, for a limited
+    //! number of tries in order to not wake up forever when the window manager disagrees
     m_validateGeometryTimer.setSingleShot(true);
     m_validateGeometryTimer.setInterval(500);
-    connect(&m_validateGeometryTimer, &QTimer::timeout, this, &Positioner::syncGeometry);
+    connect(&m_validateGeometryTimer, &QTimer::timeout, this, [&]() {
+        m_correctiveSyncs++;
+        syncGeometry();
+    });
 
     //! syncGeometry() function is costly, so now we make sure that is not executed too often
     m_syncGeometryTimer.setSingleShot(true);
     m_syncGeometryTimer.setInterval(150);
     connect(&m_syncGeometryTimer, &QTimer::timeout, this, &Positioner::immediateSyncGeometry);
 
+    //! screens are tracked through screen signals, periodic polling is used only
+    //! when it is explicitly requested e.g. for drivers that miss screen events
+    m_screenPollingTimer.setSingleShot(false);
+    m_screenPollingTimer.setInterval(2000);
+    connect(&m_screenPollingTimer, &QTimer::timeout, this, &Positioner::reconsiderScreen);
+
+    for (auto timer : {&m_screenSyncTimer, &m_validateGeometryTimer, &m_syncGeometryTimer, &m_screenPollingTimer}) {
+        connect(timer, &QTimer::timeout, this, &Positioner::countWakeup);
+    }
+
+    m_wakeupsTimer.start();
+
+    //! the window size is known only after the transaction has applied it
+    connect(m_view->geometryTransaction(), &GeometryTransaction::committed, this, [&](GeometryTransaction::Changes changes) {
+        if ((changes & GeometryTransaction::SizeChange) && m_view->formFactor() == Plasma::Types::Horizontal) {
+            emit windowSizeChanged();
+        }
+    });
+
     m_corona = qobject_cast<Latte::Corona *>(m_view->corona());
 
     if (m_corona) {
@@ -85,8 +113,10 @@ Positioner::Positioner(Latte::View *parent)
         /////
 
         m_screenSyncTimer.setInterval(qMax(m_corona->universalSettings()->screenTrackerInterval() - 500, 1000));
+        m_screenPollingTimer.setInterval(m_corona->universalSettings()->screenTrackerInterval());
         connect(m_corona->universalSettings(), &UniversalSettings::screenTrackerIntervalChanged, this, [&]() {
             m_screenSyncTimer.setInterval(qMax(m_corona->universalSettings()->screenTrackerInterval() - 500, 1000));
+            m_screenPollingTimer.setInterval(m_corona->universalSettings()->screenTrackerInterval());
         });
 
         connect(m_corona, &Latte::Corona::viewLocationChanged, this, [&]() {
@@ -96,6 +126,15 @@ Positioner::Positioner(Latte::View *parent)
                 m_screenSyncTimer.start();
             }
         });
+
+        connect(m_corona->screenPool(), &ScreenPool::primaryPoolChanged, this, [&]() {
+            if (m_view->onPrimary()) {
+                screenChanged(qGuiApp->primaryScreen());
+            }
+        });
+
+        connect(m_corona->universalSettings(), &UniversalSettings::screenPollingChanged, this, &Positioner::updateScreenPolling);
+        updateScreenPolling();
     }
 
     init();
@@ -108,6 +147,7 @@ Positioner::~Positioner()
 
     m_screenSyncTimer.stop();
     m_validateGeometryTimer.stop();
+    m_screenPollingTimer.stop();
 }
 
 void Positioner::init()
@@ -210,7 +250,7 @@ void Positioner::init()
         }
     });
 
-    connect(qGuiApp, &QGuiApplication::screenAdded, this, &Positioner::screenChanged);
+    //! screens that are added or removed are reconciled from the layout for all views together
     connect(qGuiApp, &QGuiApplication::primaryScreenChanged, this, &Positioner::screenChanged);
 
     connect(m_view, &Latte::View::visibilityChanged, this, &Positioner::initDelayedSignals);
@@ -247,6 +287,39 @@ void Positioner::updateWaylandId()
     }
 }
 
+int Positioner::wakeupsPerMinute() const
+{
+    //! it is computed when it is read, that way an idle view reports no wakeups
+    //! and measuring does not wake up the view by itself
+    const qint64 periodStart = m_wakeupsTimer.elapsed() - WAKEUPSPERIOD;
+    int wakeups{0};
+
+    for (auto it = m_wakeups.crbegin(); it != m_wakeups.crend() && *it > periodStart; ++it) {
+        wakeups++;
+    }
+
+    return wakeups;
+}
+
+void Positioner::countWakeup()
+{
+    const qint64 now = m_wakeupsTimer.elapsed();
+    m_wakeups.enqueue(now);
+
+    while (m_wakeups.head() <= now - WAKEUPSPERIOD) {
+        m_wakeups.dequeue();
+    }
+}
+
+void Positioner::updateScreenPolling()
+{
+    if (m_corona->universalSettings()->screenPolling()) {
+        m_screenPollingTimer.start();
+    } else {
+        m_screenPollingTimer.stop();
+    }
+}
+
 int Positioner::currentScreenId() const
 {
     auto *latteCorona = qobject_cast<Latte::Corona *>(m_view->corona());
@@ -373,6 +446,10 @@ void Positioner::setScreenToFollow(QScreen *scr, bool updateScreenId)
 
     qDebug() << "setScreenToFollow() called for screen:" << scr->name() << " update:" << updateScreenId;
 
+    if (m_screenToFollow) {
+        disconnect(m_screenToFollow, &QScreen::geometryChanged, this, &Positioner::onScreenGeometryChanged);
+    }
+
     m_screenToFollow = scr;
 
     if (updateScreenId) {
@@ -384,7 +461,7 @@ void Positioner::setScreenToFollow(QScreen *scr, bool updateScreenId)
 
     updateContainmentScreen();
 
-    connect(scr, &QScreen::geometryChanged, this, &Positioner::screenGeometryChanged);
+    connect(scr, &QScreen::geometryChanged, this, &Positioner::onScreenGeometryChanged);
     syncGeometry();
     m_view->updateAbsoluteGeometry(true);
     qDebug() << "setScreenToFollow() ended...";
@@ -444,8 +521,16 @@ void Positioner::reconsiderScreen()
     qDebug() << "reconsiderScreen() ended...";
 }
 
+void Positioner::onScreenGeometryChanged()
+{
+    m_correctiveSyncs = 0;
+    emit screenGeometryChanged();
+}
+
 void Positioner::screenChanged(QScreen *scr)
 {
+    //! a real screen event, window manager misplacements can be corrected again
+    m_correctiveSyncs = 0;
     m_screenSyncTimer.start();
 
     //! this is needed in order to update the struts on screen change
@@ -484,7 +569,8 @@ void Positioner::immediateSyncGeometry()
             qDebug() << "Sync Geometry screens inconsistent for m_screenToFollow:" << m_screenToFollow->name() << " dock screen:" << m_view->screen()->name();
         }
 
-        if (!m_screenSyncTimer.isActive()) {
+        if (!m_screenSyncTimer.isActive() && m_correctiveSyncs < MAXCORRECTIVESYNCS) {
+            m_correctiveSyncs++;
             m_screenSyncTimer.start();
         }
     } else {
@@ -576,7 +662,14 @@ void Positioner::immediateSyncGeometry()
 
 void Positioner::validateDockGeometry()
 {
-    if (m_slideOffset==0 && m_view->geometry() != m_validGeometry) {
+    if (m_slideOffset!=0) {
+        return;
+    }
+
+    if (m_view->geometry() == m_validGeometry) {
+        m_correctiveSyncs = 0;
+        m_validateGeometryTimer.stop();
+    } else if (m_correctiveSyncs < MAXCORRECTIVESYNCS) {
         m_validateGeometryTimer.start();
     }
 }
@@ -730,6 +823,9 @@ void Positioner::updatePosition(QRect availableScreenRect)
 
     int cleanThickness = m_view->normalThickness() - m_view->effects()->innerShadow();
 
+    //! the window may have a resize that is not committed yet
+    QSize windowSize = m_view->geometryTransaction()->size();
+
     int screenEdgeMargin = m_view->behaveAsPlasmaPanel() ? m_view->screenEdgeMargin() - qAbs(m_slideOffset) : 0;
 
     switch (m_view->location()) {
@@ -762,7 +858,7 @@ void Positioner::updatePosition(QRect availableScreenRect)
                 position = {screenGeometry.x() + gapCentered(screenGeometry.width()), y};
             }
         } else {
-            position = {screenGeometry.x(), screenGeometry.y() + screenGeometry.height() - m_view->height()};
+            position = {screenGeometry.x(), screenGeometry.y() + screenGeometry.height() - windowSize.height()};
         }
 
         break;
@@ -779,7 +875,7 @@ void Positioner::updatePosition(QRect availableScreenRect)
                 position = {x, availableScreenRect.y() + gapCentered(availableScreenRect.height())};
             }
         } else {
-            position = {availableScreenRect.right() - m_view->width() + 1, availableScreenRect.y()};
+            position = {availableScreenRect.right() - windowSize.width() + 1, availableScreenRect.y()};
         }
 
         break;
@@ -820,11 +916,7 @@ void Positioner::updatePosition(QRect availableScreenRect)
         }
     }
 
-    m_view->setPosition(position);
-
-    if (m_view->surface()) {
-        m_view->surface()->setPosition(position);
-    }
+    m_view->geometryTransaction()->setPosition(position);
 }
 
 int Positioner::slideOffset() const
@@ -863,13 +955,7 @@ void Positioner::resizeWindow(QRect availableScreenRect)
 
     m_validGeometry.setSize(size);
 
-    m_view->setMinimumSize(size);
-    m_view->setMaximumSize(size);
-    m_view->resize(size);
-
-    if (m_view->formFactor() == Plasma::Types::Horizontal) {
-        emit windowSizeChanged();
-    }
+    m_view->geometryTransaction()->setSize(size);
 }
 
 void Positioner::updateFormFactor()
@@ -24,8 +24,10 @@
 #include "../wm/windowinfowrap.h"
 
 // Qt
+#include <QElapsedTimer>
 #include <QObject>
 #include <QPointer>
+#include <QQueue>
 #include <QScreen>
 #include <QTimer>
 
@@ -85,6 +87,9 @@ public:
 
     QRect canvasGeometry();
 
+    //! timer wakeups during the last minute, it helps to verify that an idle view stays quiet
+    int wakeupsPerMinute() const;
+
     void setScreenToFollow(QScreen *scr, bool updateScreenId = true);
 
     void reconsiderScreen();
@@ -138,6 +143,9 @@ private slots:
     void onCurrentLayoutIsSwitching(const QString &layoutName);
 
     void validateDockGeometry();
+    void onScreenGeometryChanged();
+    void countWakeup();
+    void updateScreenPolling();
     void updateInLocationAnimation();
     void syncLatteViews();
     void updateContainmentScreen();
@@ -168,6 +176,13 @@ private:
 
     int m_slideOffset{0};
 
+    //! corrective syncs since the last screen event or the last valid geometry
+    int m_correctiveSyncs{0};
+
+    //! times of the wakeups during the last minute
+    QQueue<qint64> m_wakeups;
+    QElapsedTimer m_wakeupsTimer;
+
     QRect m_canvasGeometry;
     //! it is used in order to enforce X11 to never miss window geometry
     QRect m_validGeometry;
@@ -183,6 +198,7 @@ private:
     QTimer m_screenSyncTimer;
     QTimer m_syncGeometryTimer;
     QTimer m_validateGeometryTimer;
+    QTimer m_screenPollingTimer;
 
     //!used at sliding out/in animation
     QString m_moveToLayout;
@@ -23,6 +23,7 @@
 // local
 #include "contextmenu.h"
 #include "effects.h"
+#include "geometrytransaction.h"
 #include "positioner.h"
 #include "visibilitymanager.h"
 #include "settings/primaryconfigview.h"
@@ -76,12 +77,36 @@ namespace Latte {
 //! are needed in order for window flags to be set correctly
 View::View(Plasma::Corona *corona, QScreen *targetScreen, bool byPassWM)
     : PlasmaQuick::ContainmentView(corona),
+      m_geometryTransaction(new ViewPart::GeometryTransaction(this)),
       m_contextMenu(new ViewPart::ContextMenu(this)),
       m_effects(new ViewPart::Effects(this)),
       m_interface(new ViewPart::ContainmentInterface(this)),
       m_parabolic(new ViewPart::Parabolic(this)),
       m_sink(new ViewPart::EventsSink(this))
 {      
+    //! the corona memoizes the available screen areas, they are invalidated before any
+    //! view part or corona client reacts to a change of this view footprint
+    if (auto latteCorona = qobject_cast<Latte::Corona *>(corona)) {
+        connect(this, &QWindow::xChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &QWindow::yChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &QWindow::widthChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &QWindow::heightChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &QWindow::screenChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &View::containmentChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &View::locationChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &View::formFactorChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &View::alignmentChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &View::behaveAsPlasmaPanelChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &View::maxLengthChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &View::normalThicknessChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &View::offsetChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &View::screenEdgeMarginChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &View::visibilityChanged, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        //! visibility mode changes are sent through them
+        connect(this, &View::availableScreenRectChangedFrom, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+        connect(this, &View::availableScreenRegionChangedFrom, latteCorona, &Latte::Corona::invalidateAvailableScreenAreas);
+    }
+
     //! needs to be created after Effects because it catches some of its signals
     //! and avoid a crash from View::winId() at the same time
     m_positioner = new ViewPart::Positioner(this);
@@ -264,6 +289,11 @@ View::~View()
     if (m_windowsTracker) {
         delete m_windowsTracker;
     }
+
+    //! it is deleted last because all view parts are sending their window changes through it
+    if (m_geometryTransaction) {
+        delete m_geometryTransaction;
+    }
 }
 
 void View::init(Plasma::Containment *plasma_containment)
@@ -386,6 +416,8 @@ void View::disconnectSensitiveSignals()
     disconnect(this, &View::availableScreenRegionChangedFrom, m_corona, &Latte::Corona::availableScreenRegionChangedFrom);
     disconnect(m_corona, &Latte::Corona::availableScreenRectChangedFrom, this, &View::availableScreenRectChangedFromSlot);
     disconnect(m_corona, &Latte::Corona::verticalUnityViewHasFocus, this, &View::topViewAlwaysOnTop);
+    //! the corona available screen areas are invalidated by the layout from now on
+    disconnect(this, nullptr, m_corona, nullptr);
 
     setLayout(nullptr);
 }
@@ -1279,6 +1311,11 @@ ViewPart::ContextMenu *View::contextMenu() const
     return m_contextMenu;
 }
 
+ViewPart::GeometryTransaction *View::geometryTransaction() const
+{
+    return m_geometryTransaction;
+}
+
 ViewPart::ContainmentInterface *View::extendedInterface() const
 {
     return m_interface;
@@ -74,6 +74,7 @@ class GenericLayout;
 
 namespace ViewPart {
 class ContextMenu;
+class GeometryTransaction;
 }
 }
 
@@ -235,6 +236,7 @@ public:
 
     ViewPart::Effects *effects() const;   
     ViewPart::ContextMenu *contextMenu() const;
+    ViewPart::GeometryTransaction *geometryTransaction() const;
     ViewPart::ContainmentInterface *extendedInterface() const;
     ViewPart::Indicator *indicator() const;
     ViewPart::Parabolic *parabolic() const;
@@ -430,6 +432,7 @@ private:
     QPointer<PlasmaQuick::ConfigView> m_appletConfigView;
     QPointer<ViewPart::PrimaryConfigView> m_primaryConfigView;
 
+    QPointer<ViewPart::GeometryTransaction> m_geometryTransaction;
     QPointer<ViewPart::ContextMenu> m_contextMenu;
     QPointer<ViewPart::Effects> m_effects;
     QPointer<ViewPart::Indicator> m_indicator;
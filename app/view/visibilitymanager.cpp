@@ -21,6 +21,7 @@
 #include "visibilitymanager.h"
 
 // local
+#include "geometrytransaction.h"
 #include "positioner.h"
 #include "view.h"
 #include "helpers/floatinggapwindow.h"
@@ -238,7 +239,7 @@ void VisibilityManager::setMode(Latte::Types::Visibility mode)
 
     if (m_mode == Types::AlwaysVisible) {
         //! remove struts for old always visible mode
-        m_wm->removeViewStruts(*m_latteView);
+        m_latteView->geometryTransaction()->removeStruts();
     }
 
     m_timerShow.stop();
@@ -321,8 +322,11 @@ void VisibilityManager::setMode(Latte::Types::Visibility mode)
         m_connections[base] = connect(this, &VisibilityManager::containsMouseChanged
                                       , this, &VisibilityManager::dodgeAllWindows);
 
+        //! every hint that is read must be connected, otherwise it is not requested and it is never evaluated
         m_connections[base+1] = connect(m_latteView->windowsTracker()->currentScreen(), &TrackerPart::CurrentScreenTracker::existsWindowTouchingChanged
                                         , this, &VisibilityManager::dodgeAllWindows);
+        m_connections[base+2] = connect(m_latteView->windowsTracker()->currentScreen(), &TrackerPart::CurrentScreenTracker::activeWindowTouchingChanged
+                                        , this, &VisibilityManager::dodgeAllWindows);
 
         dodgeAllWindows();
         break;
@@ -396,11 +400,11 @@ void VisibilityManager::updateStrutsBasedOnLayoutsAndActivities(bool forceUpdate
             //! though they should not. In such case setting struts when the windows are hidden
             //! the struts do not take any effect
             m_publishedStruts = computedStruts;
-            m_wm->setViewStruts(*m_latteView, m_publishedStruts, m_latteView->location());
+            m_latteView->geometryTransaction()->setStruts(m_publishedStruts, m_latteView->location());
         }
     } else {
         m_publishedStruts = QRect();
-        m_wm->removeViewStruts(*m_latteView);
+        m_latteView->geometryTransaction()->removeStruts();
     }
 }
 
@@ -580,10 +584,10 @@ void VisibilityManager::publishFrameExtents(bool forceUpdate)
             //! When a view returns its frame extents to zero then that triggers a compositor
             //! strange behavior that moves/hides the view totally and freezes entire Latte
             //! this is why we have blocked that setting
-            m_wm->setFrameExtents(m_latteView, frameExtents);
+            m_latteView->geometryTransaction()->setFrameExtents(frameExtents);
         } else if (m_latteView->behaveAsPlasmaPanel()) {
             QMargins panelExtents(0, 0, 0, 0);
-            m_wm->setFrameExtents(m_latteView, panelExtents);
+            m_latteView->geometryTransaction()->setFrameExtents(panelExtents);
             emit frameExtentsCleared();
         }
     }
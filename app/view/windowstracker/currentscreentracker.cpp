@@ -25,6 +25,10 @@
 #include "../../wm/tracker/lastactivewindow.h"
 #include "../../wm/tracker/windowstracker.h"
 
+// Qt
+#include <QMetaMethod>
+#include <QTimer>
+
 namespace Latte {
 namespace ViewPart {
 namespace TrackerPart {
@@ -119,6 +123,82 @@ void  CurrentScreenTracker::init()
             emit touchingWindowSchemeChanged();
         }
     });
+
+    //! hints that are not consumed from anyone are not evaluated
+    scheduleRequestedHintsUpdate();
+}
+
+void CurrentScreenTracker::connectNotify(const QMetaMethod &signal)
+{
+    Q_UNUSED(signal)
+    scheduleRequestedHintsUpdate();
+}
+
+void CurrentScreenTracker::disconnectNotify(const QMetaMethod &signal)
+{
+    Q_UNUSED(signal)
+    scheduleRequestedHintsUpdate();
+}
+
+void CurrentScreenTracker::scheduleRequestedHintsUpdate()
+{
+    if (m_requestedHintsUpdateScheduled) {
+        return;
+    }
+
+    //! connections are changing in bursts while QML bindings are evaluated
+    m_requestedHintsUpdateScheduled = true;
+    QTimer::singleShot(0, this, &CurrentScreenTracker::updateRequestedHints);
+}
+
+void CurrentScreenTracker::updateRequestedHints()
+{
+    m_requestedHintsUpdateScheduled = false;
+
+    using WindowSystem::Tracker::TrackedViewInfo;
+    TrackedViewInfo::ViewHints hints{TrackedViewInfo::NoViewHint};
+
+    if (isSignalConnected(QMetaMethod::fromSignal(&CurrentScreenTracker::activeWindowMaximizedChanged))) {
+        hints |= TrackedViewInfo::ActiveWindowMaximizedHint;
+    }
+
+    if (isSignalConnected(QMetaMethod::fromSignal(&CurrentScreenTracker::activeWindowTouchingChanged))) {
+        hints |= TrackedViewInfo::ActiveWindowTouchingHint;
+    }
+
+    if (isSignalConnected(QMetaMethod::fromSignal(&CurrentScreenTracker::activeWindowTouchingEdgeChanged))) {
+        hints |= TrackedViewInfo::ActiveWindowTouchingEdgeHint;
+    }
+
+    if (isSignalConnected(QMetaMethod::fromSignal(&CurrentScreenTracker::existsWindowActiveChanged))) {
+        hints |= TrackedViewInfo::ExistsWindowActiveHint;
+    }
+
+    if (isSignalConnected(QMetaMethod::fromSignal(&CurrentScreenTracker::existsWindowMaximizedChanged))) {
+        hints |= TrackedViewInfo::ExistsWindowMaximizedHint;
+    }
+
+    if (isSignalConnected(QMetaMethod::fromSignal(&CurrentScreenTracker::existsWindowTouchingChanged))) {
+        hints |= TrackedViewInfo::ExistsWindowTouchingHint;
+    }
+
+    if (isSignalConnected(QMetaMethod::fromSignal(&CurrentScreenTracker::existsWindowTouchingEdgeChanged))) {
+        hints |= TrackedViewInfo::ExistsWindowTouchingEdgeHint;
+    }
+
+    if (isSignalConnected(QMetaMethod::fromSignal(&CurrentScreenTracker::isTouchingBusyVerticalViewChanged))) {
+        hints |= TrackedViewInfo::TouchingBusyVerticalViewHint;
+    }
+
+    if (isSignalConnected(QMetaMethod::fromSignal(&CurrentScreenTracker::activeWindowSchemeChanged))) {
+        hints |= TrackedViewInfo::ActiveWindowSchemeHint;
+    }
+
+    if (isSignalConnected(QMetaMethod::fromSignal(&CurrentScreenTracker::touchingWindowSchemeChanged))) {
+        hints |= TrackedViewInfo::TouchingWindowSchemeHint;
+    }
+
+    m_wm->windowsTracker()->setRequestedHints(m_latteView, hints);
 }
 
 void CurrentScreenTracker::initSignalsForInformation()
@@ -98,13 +98,22 @@ signals:
 
     void lastActiveWindowChanged();
 
+protected:
+    //! QML bindings and c++ consumers connect to the hints they are using
+    void connectNotify(const QMetaMethod &signal) override;
+    void disconnectNotify(const QMetaMethod &signal) override;
+
 private slots:
     void initSignalsForInformation();
+    void updateRequestedHints();
 
 private:
     void init();
+    void scheduleRequestedHintsUpdate();
 
 private:
+    bool m_requestedHintsUpdateScheduled{false};
+
     Latte::View *m_latteView{nullptr};
     WindowSystem::AbstractWindowInterface *m_wm{nullptr};
 };
@@ -21,6 +21,7 @@
 #include "abstractwindowinterface.h"
 
 // local
+#include "tracerecorder.h"
 #include "tracker/schemes.h"
 #include "tracker/windowstracker.h"
 #include "../lattecorona.h"
@@ -54,8 +55,10 @@ AbstractWindowInterface::AbstractWindowInterface(QObject *parent)
 
     connect(&m_windowWaitingTimer, &QTimer::timeout, this, [&]() {
         WindowId wid = m_windowChangedWaiting;
+        WindowProperties properties = m_windowChangedWaitingProperties;
         m_windowChangedWaiting = QVariant();
-        emit windowChanged(wid);
+        m_windowChangedWaitingProperties = NoWindowProperty;
+        emit windowChanged(wid, properties);
     });
 
     connect(this, &AbstractWindowInterface::windowRemoved, this, &AbstractWindowInterface::windowRemovedSlot);
@@ -75,10 +78,50 @@ AbstractWindowInterface::~AbstractWindowInterface()
 {
     m_windowWaitingTimer.stop();
 
+    stopEventsRecording();
+
     m_schemesTracker->deleteLater();
     m_windowsTracker->deleteLater();
 }
 
+QList<WindowInfoWrap> AbstractWindowInterface::requestInfos(const QList<WindowId> &wids, const QList<WindowProperties> &properties)
+{
+    Q_UNUSED(properties);
+
+    QList<WindowInfoWrap> infos;
+
+    for (const auto &wid : wids) {
+        infos << requestInfo(wid);
+    }
+
+    return infos;
+}
+
+void AbstractWindowInterface::requestInfosAsync(const QList<WindowId> &wids, const QList<WindowProperties> &properties)
+{
+    emit windowInfosReceived(wids, requestInfos(wids, properties));
+}
+
+void AbstractWindowInterface::cancelInfosAsync()
+{
+}
+
+bool AbstractWindowInterface::startEventsRecording(const QString &file)
+{
+    if (!m_traceRecorder) {
+        m_traceRecorder = new TraceRecorder(this);
+    }
+
+    return m_traceRecorder->start(file);
+}
+
+void AbstractWindowInterface::stopEventsRecording()
+{
+    if (m_traceRecorder) {
+        m_traceRecorder->stop();
+    }
+}
+
 QString AbstractWindowInterface::currentDesktop()
 {
     return m_currentDesktop;
@@ -104,9 +147,42 @@ Tracker::Windows *AbstractWindowInterface::windowsTracker() const
     return m_windowsTracker;
 }
 
+bool AbstractWindowInterface::addRegistration(const WindowId &wid, const WindowRegistration &registration)
+{
+    if (wid.isNull()) {
+        return false;
+    }
+
+    WindowRegistrations &registrations = m_registeredWindows[wid];
+
+    if (registrations & registration) {
+        return false;
+    }
+
+    registrations |= registration;
+    return true;
+}
+
+bool AbstractWindowInterface::removeRegistration(const WindowId &wid, const WindowRegistration &registration)
+{
+    auto it = m_registeredWindows.find(wid);
+
+    if (it == m_registeredWindows.end() || !(it.value() & registration)) {
+        return false;
+    }
+
+    it.value() &= ~registration;
+
+    if (it.value() == NoRegistration) {
+        m_registeredWindows.erase(it);
+    }
+
+    return true;
+}
+
 bool AbstractWindowInterface::isIgnored(const WindowId &wid) const
 {
-    return m_ignoredWindows.contains(wid);
+    return m_registeredWindows.value(wid) & IgnoredRegistration;
 }
 
 bool AbstractWindowInterface::isFullScreenWindow(const QRect &wGeometry) const
@@ -182,17 +258,20 @@ bool AbstractWindowInterface::isSidepanel(const QRect &wGeometry) const
 
 bool AbstractWindowInterface::hasBlockedTracking(const WindowId &wid) const
 {
-    return (!isWhitelistedWindow(wid) && (isRegisteredPlasmaIgnoredWindow(wid) || isIgnored(wid)));
+    WindowRegistrations registrations = m_registeredWindows.value(wid);
+
+    return (!(registrations & WhitelistedRegistration)
+            && (registrations & (PlasmaIgnoredRegistration | IgnoredRegistration)));
 }
 
 bool AbstractWindowInterface::isRegisteredPlasmaIgnoredWindow(const WindowId &wid) const
 {
-    return m_plasmaIgnoredWindows.contains(wid);
+    return m_registeredWindows.value(wid) & PlasmaIgnoredRegistration;
 }
 
 bool AbstractWindowInterface::isWhitelistedWindow(const WindowId &wid) const
 {
-    return m_whitelistedWindows.contains(wid);
+    return m_registeredWindows.value(wid) & WhitelistedRegistration;
 }
 
 bool AbstractWindowInterface::inCurrentDesktopActivity(const WindowInfoWrap &winfo)
@@ -203,61 +282,55 @@ bool AbstractWindowInterface::inCurrentDesktopActivity(const WindowInfoWrap &win
 //! Register Latte Ignored Windows in order to NOT be tracked
 void AbstractWindowInterface::registerIgnoredWindow(WindowId wid)
 {
-    if (!wid.isNull() && !m_ignoredWindows.contains(wid)) {
-        m_ignoredWindows.append(wid);
+    if (addRegistration(wid, IgnoredRegistration)) {
         emit windowChanged(wid);
     }
 }
 
 void AbstractWindowInterface::unregisterIgnoredWindow(WindowId wid)
 {
-    if (m_ignoredWindows.contains(wid)) {
-        m_ignoredWindows.removeAll(wid);
+    if (removeRegistration(wid, IgnoredRegistration)) {
         emit windowRemoved(wid);
     }
 }
 
 void AbstractWindowInterface::registerPlasmaIgnoredWindow(WindowId wid)
 {
-    if (!wid.isNull() && !m_plasmaIgnoredWindows.contains(wid)) {
-        m_plasmaIgnoredWindows.append(wid);
+    if (addRegistration(wid, PlasmaIgnoredRegistration)) {
         emit windowChanged(wid);
     }
 }
 
 void AbstractWindowInterface::unregisterPlasmaIgnoredWindow(WindowId wid)
 {
-    if (m_plasmaIgnoredWindows.contains(wid)) {
-        m_plasmaIgnoredWindows.removeAll(wid);
-    }
+    removeRegistration(wid, PlasmaIgnoredRegistration);
 }
 
 void AbstractWindowInterface::registerWhitelistedWindow(WindowId wid)
 {
-    if (!wid.isNull() && !m_whitelistedWindows.contains(wid)) {
-        m_whitelistedWindows.append(wid);
+    if (addRegistration(wid, WhitelistedRegistration)) {
         emit windowChanged(wid);
     }
 }
 
 void AbstractWindowInterface::unregisterWhitelistedWindow(WindowId wid)
 {
-    if (m_whitelistedWindows.contains(wid)) {
-        m_whitelistedWindows.removeAll(wid);
-    }
+    removeRegistration(wid, WhitelistedRegistration);
 }
 
 void AbstractWindowInterface::windowRemovedSlot(WindowId wid)
 {
-    if (m_plasmaIgnoredWindows.contains(wid)) {
+    WindowRegistrations registrations = m_registeredWindows.value(wid);
+
+    if (registrations & PlasmaIgnoredRegistration) {
         unregisterPlasmaIgnoredWindow(wid);
     }
 
-    if (m_ignoredWindows.contains(wid)) {
+    if (registrations & IgnoredRegistration) {
         unregisterIgnoredWindow(wid);
     }
 
-    if (m_whitelistedWindows.contains(wid)) {
+    if (registrations & WhitelistedRegistration) {
         unregisterWhitelistedWindow(wid);
     }
 }
@@ -300,12 +373,13 @@ void AbstractWindowInterface::switchToPreviousActivity()
 }
 
 //! Delay window changed trigerring
-void AbstractWindowInterface::considerWindowChanged(WindowId wid)
+void AbstractWindowInterface::considerWindowChanged(WindowId wid, const WindowProperties &properties)
 {
     //! Consider if the windowChanged signal should be sent DIRECTLY or WAIT
 
     if (m_windowChangedWaiting == wid && m_windowWaitingTimer.isActive()) {
-        //! window should be sent later
+        //! window should be sent later, all changed properties are sent together
+        m_windowChangedWaitingProperties |= properties;
         m_windowWaitingTimer.start();
         return;
     }
@@ -313,16 +387,18 @@ void AbstractWindowInterface::considerWindowChanged(WindowId wid)
     if (m_windowChangedWaiting != wid && !m_windowWaitingTimer.isActive()) {
         //! window should be sent later
         m_windowChangedWaiting = wid;
+        m_windowChangedWaitingProperties = properties;
         m_windowWaitingTimer.start();
     }
 
     if (m_windowChangedWaiting != wid && m_windowWaitingTimer.isActive()) {
         m_windowWaitingTimer.stop();
         //! sent previous waiting window
-        emit windowChanged(m_windowChangedWaiting);
+        emit windowChanged(m_windowChangedWaiting, m_windowChangedWaitingProperties);
 
         //! retrigger waiting for the upcoming window
         m_windowChangedWaiting = wid;
+        m_windowChangedWaitingProperties = properties;
         m_windowWaitingTimer.start();
     }
 }
@@ -36,6 +36,7 @@
 #include <QObject>
 #include <QWindow>
 #include <QDialog>
+#include <QHash>
 #include <QMap>
 #include <QRect>
 #include <QPoint>
@@ -54,6 +55,7 @@
 namespace Latte {
 class Corona;
 namespace WindowSystem {
+class TraceRecorder;
 namespace Tracker {
 class Schemes;
 class Windows;
@@ -78,6 +80,15 @@ public:
         Right,
     };
 
+    enum WindowRegistration
+    {
+        NoRegistration = 0x00,
+        IgnoredRegistration = 0x01,
+        PlasmaIgnoredRegistration = 0x02,
+        WhitelistedRegistration = 0x04
+    };
+    Q_DECLARE_FLAGS(WindowRegistrations, WindowRegistration)
+
     explicit AbstractWindowInterface(QObject *parent = nullptr);
     virtual ~AbstractWindowInterface();
 
@@ -92,6 +103,15 @@ public:
     virtual WindowInfoWrap requestInfo(WindowId wid) = 0;
     virtual WindowInfoWrap requestInfoActive() = 0;
 
+    //! batched window information requests, the returned infos follow the order of the provided wids;
+    //! implementations can pipeline the window system round trips for the entire batch. When properties
+    //! are provided, per window, implementations can request only the relevant window information
+    virtual QList<WindowInfoWrap> requestInfos(const QList<WindowId> &wids, const QList<WindowProperties> &properties = QList<WindowProperties>());
+    //! non-blocking variant, results are delivered through windowInfosReceived()
+    virtual void requestInfosAsync(const QList<WindowId> &wids, const QList<WindowProperties> &properties = QList<WindowProperties>());
+    //! pending non-blocking requests are dropped and their results are never delivered
+    virtual void cancelInfosAsync();
+
     virtual void skipTaskBar(const QDialog &dialog) = 0;
     virtual void slideWindow(QWindow &view, Slide location) = 0;
     virtual void enableBlurBehind(QWindow &view) = 0;
@@ -140,32 +160,35 @@ public:
     virtual void setFrameExtents(QWindow *view, const QMargins &margins) = 0;
     virtual void setInputMask(QWindow *window, const QRect &rect) = 0;
 
+    //! window system events are recorded in a trace file in order to be replayed afterwards
+    bool startEventsRecording(const QString &file);
+    void stopEventsRecording();
+
     Latte::Corona *corona();
     Tracker::Schemes *schemesTracker();
     Tracker::Windows *windowsTracker() const;
 
 signals:
     void activeWindowChanged(WindowId wid);
-    void windowChanged(WindowId winfo);
+    void windowChanged(WindowId winfo, const WindowProperties &properties = AllWindowProperties);
     void windowAdded(WindowId wid);
     void windowRemoved(WindowId wid);
     void currentDesktopChanged();
     void currentActivityChanged();
 
+    void windowInfosReceived(const QList<WindowId> &wids, const QList<WindowInfoWrap> &infos);
+
     void latteWindowAdded();
 
 protected:
     QString m_currentDesktop;
     QString m_currentActivity;
 
-    //! windows that must be ignored from tracking, a good example are Latte::Views and
-    //! their Configuration windows
-    QList<WindowId> m_ignoredWindows;
-    //! identified plasma panels
-    QList<WindowId> m_plasmaIgnoredWindows;
-
-    //! identified whitelisted windows that can be tracked e.g. plasma widgets explorer and activities
-    QList<WindowId> m_whitelistedWindows;
+    //! all window registrations are kept in a single hash in order to identify blocked windows
+    //! with just one lookup. Ignored windows must be ignored from tracking, a good example are
+    //! Latte::Views and their Configuration windows. Plasma ignored windows are the identified
+    //! plasma panels. Whitelisted windows can be tracked e.g. plasma widgets explorer and activities
+    QHash<WindowKey, WindowRegistrations> m_registeredWindows;
 
     QPointer<KActivities::Consumer> m_activities;
 
@@ -173,12 +196,17 @@ protected:
     //! has no reason and can create HIGH CPU usage. This Timer
     //! can delay the batch sending of signals for the same window
     WindowId m_windowChangedWaiting;
+    WindowProperties m_windowChangedWaitingProperties{NoWindowProperty};
     QTimer m_windowWaitingTimer;
 
     //! Plasma taskmanager rules ile
     KSharedConfig::Ptr rulesConfig;
 
-    void considerWindowChanged(WindowId wid);
+    void considerWindowChanged(WindowId wid, const WindowProperties &properties = AllWindowProperties);
+
+    //! return true when the registration was not already set or removed
+    bool addRegistration(const WindowId &wid, const WindowRegistration &registration);
+    bool removeRegistration(const WindowId &wid, const WindowRegistration &registration);
 
     bool isIgnored(const WindowId &wid) const;
     bool isRegisteredPlasmaIgnoredWindow(const WindowId &wid) const;
@@ -195,9 +223,12 @@ private:
     Latte::Corona *m_corona;
     Tracker::Schemes *m_schemesTracker;
     Tracker::Windows *m_windowsTracker;
+    TraceRecorder *m_traceRecorder{nullptr};
 };
 
 }
 }
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(Latte::WindowSystem::AbstractWindowInterface::WindowRegistrations)
+
 #endif // ABSTRACTWINDOWINTERFACE_H
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "appidentitycache.h"
+
+// local
+#include "tasktools.h"
+
+// Qt
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+// KDE
+#include <KSharedConfig>
+#include <KSycoca>
+
+namespace Latte {
+namespace WindowSystem {
+
+const quint32 CACHEVERSION = 1;
+const int SAVEINTERVAL = 5000;
+
+//! when the window identity is not known yet only the command line of its process is
+//! read, otherwise the application url of that identity is resolved
+class WindowUrlResolver : public QRunnable
+{
+public:
+    WindowUrlResolver(AppIdentityCache *cache, int generation, const QString &windowKey, const QString &identity,
+                      const QString &appId, quint32 pid, const QString &xWindowsWMClassName)
+        : m_cache(cache),
+          m_generation(generation),
+          m_windowKey(windowKey),
+          m_identity(identity),
+          m_appId(appId),
+          m_pid(pid),
+          m_xWindowsWMClassName(xWindowsWMClassName)
+    {
+    }
+
+    void run() override
+    {
+        if (m_identity.isEmpty()) {
+            QString identity = m_appId + QLatin1String("::") + m_xWindowsWMClassName + QLatin1String("::") + commandLineFromPid(m_pid);
+
+            QMetaObject::invokeMethod(m_cache, "storeWindowIdentity", Qt::QueuedConnection,
+                                      Q_ARG(int, m_generation), Q_ARG(QString, m_windowKey), Q_ARG(QString, identity),
+                                      Q_ARG(QString, m_appId), Q_ARG(uint, m_pid), Q_ARG(QString, m_xWindowsWMClassName));
+            return;
+        }
+
+        //! rules config and services database must not be shared with the GUI thread
+        KSharedConfig::Ptr rulesConfig = KSharedConfig::openConfig(QStringLiteral("taskmanagerrulesrc"));
+        QUrl url = windowUrlFromMetadata(m_appId, m_pid, rulesConfig, m_xWindowsWMClassName);
+
+        QMetaObject::invokeMethod(m_cache, "storeWindowUrl", Qt::QueuedConnection,
+                                  Q_ARG(int, m_generation), Q_ARG(QString, m_windowKey), Q_ARG(QString, m_identity), Q_ARG(QUrl, url));
+    }
+
+private:
+    AppIdentityCache *m_cache{nullptr};
+    int m_generation{0};
+    QString m_windowKey;
+    QString m_identity;
+    QString m_appId;
+    quint32 m_pid{0};
+    QString m_xWindowsWMClassName;
+};
+
+AppIdentityCache::AppIdentityCache(QObject *parent)
+    : QObject(parent)
+{
+    //! resolutions are serialized, they are not urgent and they should not compete with the GUI
+    m_resolvers.setMaxThreadCount(1);
+
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(SAVEINTERVAL);
+    connect(&m_saveTimer, &QTimer::timeout, this, &AppIdentityCache::save);
+
+    connect(KSycoca::self(), SIGNAL(databaseChanged(QStringList)), this, SLOT(clear()));
+
+    load();
+}
+
+AppIdentityCache::~AppIdentityCache()
+{
+    m_resolvers.clear();
+    m_resolvers.waitForDone();
+
+    if (m_saveTimer.isActive()) {
+        m_saveTimer.stop();
+        save();
+    }
+}
+
+AppIdentityCache *AppIdentityCache::self()
+{
+    static AppIdentityCache cache;
+    return &cache;
+}
+
+QString AppIdentityCache::cacheFile() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/lattedock/appidentities");
+}
+
+qint64 AppIdentityCache::servicesTimestamp() const
+{
+    return QFileInfo(KSycoca::absoluteFilePath()).lastModified().toMSecsSinceEpoch();
+}
+
+QUrl AppIdentityCache::windowUrl(const WindowId &wid, const QString &appId, quint32 pid, const QString &xWindowsWMClassName, bool *pending)
+{
+    QString windowKey = appId + QLatin1String("::") + xWindowsWMClassName + QLatin1String("::") + QString::number(pid);
+    auto previousKey = m_windowKeys.constFind(wid);
+
+    if (previousKey == m_windowKeys.constEnd() || previousKey.value() != windowKey) {
+        if (previousKey != m_windowKeys.constEnd()) {
+            releaseWindowKey(previousKey.value());
+        }
+
+        m_windowKeys[wid] = windowKey;
+        m_windowKeyWindows[windowKey]++;
+    }
+
+    QString identity = m_windowIdentities.value(windowKey);
+
+    if (!identity.isEmpty()) {
+        auto it = m_windowUrls.constFind(identity);
+
+        if (it != m_windowUrls.constEnd()) {
+            if (pending) {
+                *pending = false;
+            }
+
+            return it.value();
+        }
+    }
+
+    if (pending) {
+        *pending = true;
+    }
+
+    if (!m_pendingKeys.contains(windowKey)) {
+        m_pendingKeys << windowKey;
+        resolve(windowKey, identity, appId, pid, xWindowsWMClassName);
+    }
+
+    return QUrl();
+}
+
+void AppIdentityCache::removeWindow(const WindowId &wid)
+{
+    QString windowKey = m_windowKeys.take(wid);
+
+    if (!windowKey.isEmpty()) {
+        releaseWindowKey(windowKey);
+    }
+}
+
+void AppIdentityCache::releaseWindowKey(const QString &windowKey)
+{
+    if (--m_windowKeyWindows[windowKey] > 0) {
+        return;
+    }
+
+    m_windowKeyWindows.remove(windowKey);
+    m_windowIdentities.remove(windowKey);
+    m_pendingKeys.remove(windowKey);
+}
+
+void AppIdentityCache::resolve(const QString &windowKey, const QString &identity,
+                               const QString &appId, quint32 pid, const QString &xWindowsWMClassName)
+{
+    m_resolvers.start(new WindowUrlResolver(this, m_generation, windowKey, identity, appId, pid, xWindowsWMClassName));
+}
+
+void AppIdentityCache::storeWindowIdentity(int generation, const QString &windowKey, const QString &identity,
+                                           const QString &appId, uint pid, const QString &xWindowsWMClassName)
+{
+    if (!m_windowKeyWindows.contains(windowKey)) {
+        //! all windows of that process were removed while it was resolved
+        return;
+    }
+
+    //! process command lines do not depend on the services database
+    m_windowIdentities[windowKey] = identity;
+
+    if (generation != m_generation) {
+        return;
+    }
+
+    auto it = m_windowUrls.constFind(identity);
+
+    if (it == m_windowUrls.constEnd()) {
+        resolve(windowKey, identity, appId, pid, xWindowsWMClassName);
+        return;
+    }
+
+    m_pendingKeys.remove(windowKey);
+
+    if (!it.value().isEmpty()) {
+        emit windowUrlResolved();
+    }
+}
+
+void AppIdentityCache::storeWindowUrl(int generation, const QString &windowKey, const QString &identity, const QUrl &url)
+{
+    if (generation != m_generation) {
+        return;
+    }
+
+    m_pendingKeys.remove(windowKey);
+
+    //! an empty url marks a window that can not be resolved
+    m_windowUrls[identity] = url;
+    m_saveTimer.start();
+
+    if (!url.isEmpty()) {
+        emit windowUrlResolved();
+    }
+}
+
+void AppIdentityCache::clear()
+{
+    m_generation++;
+    m_windowUrls.clear();
+    m_pendingKeys.clear();
+
+    m_saveTimer.start();
+}
+
+void AppIdentityCache::load()
+{
+    QFile file(cacheFile());
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream in(&file);
+    quint32 version{0};
+    qint64 timestamp{0};
+    QHash<QString, QUrl> windowUrls;
+
+    in >> version >> timestamp;
+
+    if (version != CACHEVERSION || timestamp != servicesTimestamp()) {
+        //! services database changed since the cache was stored
+        return;
+    }
+
+    in >> windowUrls;
+
+    if (in.status() != QDataStream::Ok) {
+        qDebug() << "Application identities cache is corrupted and it is ignored :: " << file.fileName();
+        return;
+    }
+
+    m_windowUrls = windowUrls;
+}
+
+void AppIdentityCache::save()
+{
+    QFileInfo info(cacheFile());
+    QDir().mkpath(info.absolutePath());
+
+    QSaveFile file(info.absoluteFilePath());
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream out(&file);
+    out << CACHEVERSION << servicesTimestamp() << m_windowUrls;
+
+    file.commit();
+}
+
+}
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef APPIDENTITYCACHE_H
+#define APPIDENTITYCACHE_H
+
+// local
+#include "windowinfowrap.h"
+
+// Qt
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <QUrl>
+
+namespace Latte {
+namespace WindowSystem {
+
+//! Windows to application urls resolution is expensive because it queries the services
+//! database many times. Results are cached by (window class, app id, command line), they are
+//! stored on disk between sessions and they are invalidated when the services database changes.
+//! Windows are looked up by (window class, app id, pid) and the command line of each pid is
+//! read only once while windows of that process exist. Cache misses are resolved in a worker
+//! thread in order to not block the GUI. Windows that can not be resolved are cached with an empty url.
+class AppIdentityCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static AppIdentityCache *self();
+    ~AppIdentityCache() override;
+
+    //! returns an empty url until the application url has been resolved, pending is
+    //! false when the url is final even if it is empty
+    QUrl windowUrl(const WindowId &wid, const QString &appId, quint32 pid = 0, const QString &xWindowsWMClassName = QString(), bool *pending = nullptr);
+    //! the process identity is forgotten when its last window is removed, that way
+    //! a reused pid is not mistaken for the previous process
+    void removeWindow(const WindowId &wid);
+
+signals:
+    //! it is not sent for windows that could not be resolved
+    void windowUrlResolved();
+
+private slots:
+    void clear();
+    void save();
+    void storeWindowIdentity(int generation, const QString &windowKey, const QString &identity,
+                             const QString &appId, uint pid, const QString &xWindowsWMClassName);
+    void storeWindowUrl(int generation, const QString &windowKey, const QString &identity, const QUrl &url);
+
+private:
+    AppIdentityCache(QObject *parent = nullptr);
+
+    void load();
+    void resolve(const QString &windowKey, const QString &identity, const QString &appId, quint32 pid, const QString &xWindowsWMClassName);
+    void releaseWindowKey(const QString &windowKey);
+
+    QString cacheFile() const;
+    qint64 servicesTimestamp() const;
+
+private:
+    //! resolutions that started before the last invalidation are discarded
+    int m_generation{0};
+
+    //! (app id, window class, pid) to (app id, window class, command line)
+    QHash<QString, QString> m_windowIdentities;
+    //! windows to their (app id, window class, pid) and the windows count of each of them
+    QHash<WindowKey, QString> m_windowKeys;
+    QHash<QString, int> m_windowKeyWindows;
+    //! (app id, window class, command line) to application url
+    QHash<QString, QUrl> m_windowUrls;
+    QSet<QString> m_pendingKeys;
+
+    QThreadPool m_resolvers;
+    QTimer m_saveTimer;
+};
+
+}
+}
+
+#endif
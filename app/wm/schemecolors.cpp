@@ -22,6 +22,7 @@
 
 // local
 #include "../layouts/importer.h"
+#include "../tools/filewatcher.h"
 
 // Qt
 #include <QDebug>
@@ -30,7 +31,6 @@
 
 // KDE
 #include <KConfigGroup>
-#include <KDirWatch>
 #include <KSharedConfig>
 
 namespace Latte {
@@ -44,19 +44,12 @@ SchemeColors::SchemeColors(QObject *parent, QString scheme, bool plasmaTheme) :
 
     if (QFileInfo(pSchemeFile).exists()) {
         setSchemeFile(pSchemeFile);
-        m_schemeName = schemeName(pSchemeFile);
 
         //! track scheme file for changes
-        KDirWatch::self()->addFile(m_schemeFile);
-
-        connect(KDirWatch::self(), &KDirWatch::dirty, this, [ & ](const QString & path) {
-            if (path == m_schemeFile) {
-                updateScheme();
-            }
-        });
+        FileWatcher::self()->watchFile(m_schemeFile, this, [&](const QString &) {
+            updateScheme();
+        }, FileWatcher::DirtyChange);
     }
-
-    updateScheme();
 }
 
 SchemeColors::~SchemeColors()
@@ -66,71 +59,87 @@ SchemeColors::~SchemeColors()
 
 QColor SchemeColors::backgroundColor() const
 {
-    return m_activeBackgroundColor;
+    return color(BackgroundColor);
 }
 
 QColor SchemeColors::textColor() const
 {
-    return m_activeTextColor;
+    return color(TextColor);
 }
 
 QColor SchemeColors::inactiveBackgroundColor() const
 {
-    return m_inactiveBackgroundColor;
+    return color(InactiveBackgroundColor);
 }
 
 QColor SchemeColors::inactiveTextColor() const
 {
-    return m_inactiveTextColor;
+    return color(InactiveTextColor);
 }
 
 QColor SchemeColors::highlightColor() const
 {
-    return m_highlightColor;
+    return color(HighlightColor);
 }
 
 QColor SchemeColors::highlightedTextColor() const
 {
-    return m_highlightedTextColor;
+    return color(HighlightedTextColor);
 }
 
 QColor SchemeColors::positiveTextColor() const
 {
-    return m_positiveTextColor;
+    return color(PositiveTextColor);
 }
 
 QColor SchemeColors::neutralTextColor() const
 {
-    return m_neutralTextColor;
+    return color(NeutralTextColor);
 }
 
 QColor SchemeColors::negativeTextColor() const
 {
-    return m_negativeTextColor;
+    return color(NegativeTextColor);
 }
 
 QColor SchemeColors::buttonTextColor() const
 {
-    return m_buttonTextColor;
+    return color(ButtonTextColor);
 }
 
 QColor SchemeColors::buttonBackgroundColor() const
 {
-    return m_buttonBackgroundColor;
+    return color(ButtonBackgroundColor);
 }
 
 QColor SchemeColors::buttonHoverColor() const
 {
-    return m_buttonHoverColor;
+    return color(ButtonHoverColor);
 }
 
 QColor SchemeColors::buttonFocusColor() const
 {
-    return m_buttonFocusColor;
+    return color(ButtonFocusColor);
+}
+
+QColor SchemeColors::color(const ColorRole &role) const
+{
+    loadColors();
+
+    if (!(m_colors.validColors & (1 << role))) {
+        return QColor();
+    }
+
+    return QColor::fromRgba(m_colors.colors[role]);
 }
 
 QString SchemeColors::schemeName() const
 {
+    if (!m_schemeNameLoaded) {
+        m_schemeNameLoaded = true;
+        m_schemeName = schemeName(m_schemeFile);
+    }
+
     return m_schemeName;
 }
 
@@ -207,12 +216,24 @@ QString SchemeColors::schemeName(QString originalFile)
     return generalGroup.readEntry("Name", fileNameNoExt);
 }
 
-void SchemeColors::updateScheme()
+void SchemeColors::loadColors() const
 {
-    if (m_schemeFile.isEmpty() || !QFileInfo(m_schemeFile).exists()) {
+    if (m_colorsLoaded) {
         return;
     }
 
+    m_colorsLoaded = true;
+    m_colors = readColors();
+}
+
+SchemeColors::ColorsTable SchemeColors::readColors() const
+{
+    ColorsTable table;
+
+    if (m_schemeFile.isEmpty() || !QFileInfo(m_schemeFile).exists()) {
+        return table;
+    }
+
     KSharedConfigPtr filePtr = KSharedConfig::openConfig(m_schemeFile);
     KConfigGroup wmGroup = KConfigGroup(filePtr, "WM");
     KConfigGroup selGroup = KConfigGroup(filePtr, "Colors:Selection");
@@ -220,29 +241,55 @@ void SchemeColors::updateScheme()
     KConfigGroup windowGroup = KConfigGroup(filePtr, "Colors:Window");
     KConfigGroup buttonGroup = KConfigGroup(filePtr, "Colors:Button");
 
+    auto setColor = [&table](const ColorRole &role, const QColor &color) {
+        table.colors[role] = color.rgba();
+
+        if (color.isValid()) {
+            table.validColors |= (1 << role);
+        }
+    };
+
     if (!m_basedOnPlasmaTheme) {
-        m_activeBackgroundColor = wmGroup.readEntry("activeBackground", QColor());
-        m_activeTextColor = wmGroup.readEntry("activeForeground", QColor());
-        m_inactiveBackgroundColor = wmGroup.readEntry("inactiveBackground", QColor());
-        m_inactiveTextColor = wmGroup.readEntry("inactiveForeground", QColor());
+        setColor(BackgroundColor, wmGroup.readEntry("activeBackground", QColor()));
+        setColor(TextColor, wmGroup.readEntry("activeForeground", QColor()));
+        setColor(InactiveBackgroundColor, wmGroup.readEntry("inactiveBackground", QColor()));
+        setColor(InactiveTextColor, wmGroup.readEntry("inactiveForeground", QColor()));
     } else {
-        m_activeBackgroundColor = windowGroup.readEntry("BackgroundNormal", QColor());
-        m_activeTextColor = windowGroup.readEntry("ForegroundNormal", QColor());
-        m_inactiveBackgroundColor = windowGroup.readEntry("BackgroundAlternate", QColor());
-        m_inactiveTextColor = windowGroup.readEntry("ForegroundInactive", QColor());
+        setColor(BackgroundColor, windowGroup.readEntry("BackgroundNormal", QColor()));
+        setColor(TextColor, windowGroup.readEntry("ForegroundNormal", QColor()));
+        setColor(InactiveBackgroundColor, windowGroup.readEntry("BackgroundAlternate", QColor()));
+        setColor(InactiveTextColor, windowGroup.readEntry("ForegroundInactive", QColor()));
     }
 
-    m_highlightColor = selGroup.readEntry("BackgroundNormal", QColor());
-    m_highlightedTextColor = selGroup.readEntry("ForegroundNormal", QColor());
+    setColor(HighlightColor, selGroup.readEntry("BackgroundNormal", QColor()));
+    setColor(HighlightedTextColor, selGroup.readEntry("ForegroundNormal", QColor()));
+
+    setColor(PositiveTextColor, windowGroup.readEntry("ForegroundPositive", QColor()));
+    setColor(NeutralTextColor, windowGroup.readEntry("ForegroundNeutral", QColor()));
+    setColor(NegativeTextColor, windowGroup.readEntry("ForegroundNegative", QColor()));
 
-    m_positiveTextColor = windowGroup.readEntry("ForegroundPositive", QColor());
-    m_neutralTextColor = windowGroup.readEntry("ForegroundNeutral", QColor());;
-    m_negativeTextColor = windowGroup.readEntry("ForegroundNegative", QColor());
+    setColor(ButtonTextColor, buttonGroup.readEntry("ForegroundNormal", QColor()));
+    setColor(ButtonBackgroundColor, buttonGroup.readEntry("BackgroundNormal", QColor()));
+    setColor(ButtonHoverColor, buttonGroup.readEntry("DecorationHover", QColor()));
+    setColor(ButtonFocusColor, buttonGroup.readEntry("DecorationFocus", QColor()));
+
+    return table;
+}
+
+void SchemeColors::updateScheme()
+{
+    m_schemeNameLoaded = false;
+
+    if (!m_colorsLoaded) {
+        //! colors have not been requested yet, they are going to be read when needed
+        return;
+    }
+
+    if (m_schemeFile.isEmpty() || !QFileInfo(m_schemeFile).exists()) {
+        return;
+    }
 
-    m_buttonTextColor = buttonGroup.readEntry("ForegroundNormal", QColor());
-    m_buttonBackgroundColor = buttonGroup.readEntry("BackgroundNormal", QColor());
-    m_buttonHoverColor = buttonGroup.readEntry("DecorationHover", QColor());
-    m_buttonFocusColor = buttonGroup.readEntry("DecorationFocus", QColor());
+    m_colors = readColors();
 
     emit colorsChanged();
 }
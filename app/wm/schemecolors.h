@@ -24,6 +24,7 @@
 // Qt
 #include <QObject>
 #include <QColor>
+#include <QRgb>
 
 namespace Latte {
 namespace WindowSystem {
@@ -84,27 +85,47 @@ private slots:
     void updateScheme();
 
 private:
-    bool m_basedOnPlasmaTheme{false};
-
-    QString m_schemeName;
-    QString m_schemeFile;
+    enum ColorRole
+    {
+        BackgroundColor = 0,
+        TextColor,
+        InactiveBackgroundColor,
+        InactiveTextColor,
+        HighlightColor,
+        HighlightedTextColor,
+        PositiveTextColor,
+        NeutralTextColor,
+        NegativeTextColor,
+        ButtonTextColor,
+        ButtonBackgroundColor,
+        ButtonHoverColor,
+        ButtonFocusColor,
+        ColorRolesCount
+    };
+
+    //! parsed scheme colors, roles that are not found in the scheme file are invalid
+    struct ColorsTable
+    {
+        QRgb colors[ColorRolesCount]{};
+        quint16 validColors{0};
+    };
+
+    QColor color(const ColorRole &role) const;
+
+    //! the scheme file is parsed only when its colors are requested for the first time
+    void loadColors() const;
+    ColorsTable readColors() const;
 
-    QColor m_activeBackgroundColor;
-    QColor m_activeTextColor;
+private:
+    bool m_basedOnPlasmaTheme{false};
 
-    QColor m_inactiveBackgroundColor;
-    QColor m_inactiveTextColor;
+    mutable bool m_colorsLoaded{false};
+    mutable bool m_schemeNameLoaded{false};
 
-    QColor m_highlightColor;
-    QColor m_highlightedTextColor;
-    QColor m_positiveTextColor;
-    QColor m_neutralTextColor;
-    QColor m_negativeTextColor;
+    mutable QString m_schemeName;
+    QString m_schemeFile;
 
-    QColor m_buttonTextColor;
-    QColor m_buttonBackgroundColor;
-    QColor m_buttonHoverColor;
-    QColor m_buttonFocusColor;
+    mutable ColorsTable m_colors;
 };
 
 }
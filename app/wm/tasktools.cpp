@@ -530,6 +530,24 @@ KService::List servicesFromPid(quint32 pid, KSharedConfig::Ptr rulesConfig)
 #endif
 }
 
+QString commandLineFromPid(quint32 pid)
+{
+    if (pid == 0) {
+        return QString();
+    }
+
+#if KF5_VERSION_MINOR >= 62
+    auto proc = KProcessList::processInfo(pid);
+    return proc.isValid() ? proc.command() : QString();
+#else
+    KSysGuard::Processes procs;
+    procs.updateOrAddProcess(pid);
+
+    KSysGuard::Process *proc = procs.getProcess(pid);
+    return proc ? proc->command().simplified() : QString();
+#endif
+}
+
 KService::List servicesFromCmdLine(const QString &_cmdLine, const QString &processName,
     KSharedConfig::Ptr rulesConfig)
 {
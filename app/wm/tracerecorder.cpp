@@ -0,0 +1,235 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "tracerecorder.h"
+
+// local
+#include "abstractwindowinterface.h"
+#include "tracker/windowstracker.h"
+
+// Qt
+#include <QDebug>
+
+
+namespace Latte {
+namespace WindowSystem {
+
+TraceRecorder::TraceRecorder(AbstractWindowInterface *parent)
+    : QObject(parent),
+      m_wm(parent)
+{
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    stop();
+}
+
+bool TraceRecorder::isRecording() const
+{
+    return m_file.isOpen();
+}
+
+int TraceRecorder::recordedEvents() const
+{
+    return m_recordedEvents;
+}
+
+bool TraceRecorder::start(const QString &file)
+{
+    stop();
+
+    m_file.setFileName(file);
+
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Window system events trace can not be written at :" << file;
+        return false;
+    }
+
+    m_stream.setDevice(&m_file);
+    m_stream.setVersion(Trace::STREAMVERSION);
+    m_stream << Trace::MAGIC << Trace::VERSION;
+
+    m_recordedEvents = 0;
+    m_batchedEvents = 0;
+    m_pendingEvents.clear();
+    m_hasInitialState = false;
+    m_timer.start();
+
+    //! when the tracker is still evaluating events, e.g. the windows that were added
+    //! during startup, the initial state is recorded after its batch is finished
+    if (!m_wm->windowsTracker()->hasPendingEvents()) {
+        recordInitialState();
+    }
+
+    //! window system events
+    connect(m_wm, &AbstractWindowInterface::windowAdded, this, [&](WindowId wid) {
+        addEvent(Trace::WindowAddedEvent, wid);
+    });
+
+    connect(m_wm, &AbstractWindowInterface::windowChanged, this, [&](WindowId wid, const WindowProperties &properties) {
+        addEvent(Trace::WindowChangedEvent, wid, properties);
+    });
+
+    connect(m_wm, &AbstractWindowInterface::windowRemoved, this, [&](WindowId wid) {
+        addEvent(Trace::WindowRemovedEvent, wid);
+    });
+
+    connect(m_wm, &AbstractWindowInterface::activeWindowChanged, this, [&](WindowId wid) {
+        addEvent(Trace::ActiveWindowChangedEvent, wid);
+    });
+
+    connect(m_wm, &AbstractWindowInterface::currentDesktopChanged, this, [&]() {
+        addEvent(Trace::CurrentDesktopChangedEvent, WindowId(), AllWindowProperties, m_wm->currentDesktop());
+    });
+
+    connect(m_wm, &AbstractWindowInterface::currentActivityChanged, this, [&]() {
+        addEvent(Trace::CurrentActivityChangedEvent, WindowId(), AllWindowProperties, m_wm->currentActivity());
+    });
+
+    connect(m_wm->windowsTracker(), &Tracker::Windows::eventsBatchStarted, this, &TraceRecorder::onEventsBatchStarted);
+    connect(m_wm->windowsTracker(), &Tracker::Windows::eventsBatchFinished, this, &TraceRecorder::onEventsBatchFinished);
+
+    qDebug() << "Window system events recording started at :" << file;
+
+    return true;
+}
+
+void TraceRecorder::stop()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    disconnect(m_wm, nullptr, this, nullptr);
+    disconnect(m_wm->windowsTracker(), nullptr, this, nullptr);
+
+    //! events of unfinished batches are recorded with the window information the tracker has so far
+    if (m_hasInitialState) {
+        recordPendingEvents(m_pendingEvents.count());
+    }
+
+    m_pendingEvents.clear();
+    m_batchedEvents = 0;
+
+    m_stream.setDevice(nullptr);
+    m_file.close();
+
+    qDebug() << "Window system events recording stopped, events :" << m_recordedEvents << " file :" << m_file.fileName();
+}
+
+void TraceRecorder::onEventsBatchStarted()
+{
+    //! events that arrive from now on are evaluated in the next batch
+    m_batchedEvents = m_pendingEvents.count();
+}
+
+void TraceRecorder::onEventsBatchFinished()
+{
+    if (!m_hasInitialState) {
+        //! the events of the finished batch are already part of the initial state
+        m_pendingEvents.erase(m_pendingEvents.begin(), m_pendingEvents.begin() + m_batchedEvents);
+        recordInitialState();
+    } else {
+        recordPendingEvents(m_batchedEvents);
+    }
+
+    m_batchedEvents = 0;
+}
+
+void TraceRecorder::addEvent(const Trace::EventType &type, const WindowId &wid, const WindowProperties &properties, const QString &value)
+{
+    PendingEvent event;
+    event.type = type;
+    event.time = static_cast<quint32>(m_timer.elapsed());
+    event.wid = wid;
+    event.properties = properties;
+    event.value = value;
+
+    m_pendingEvents << event;
+}
+
+void TraceRecorder::recordInitialState()
+{
+    m_hasInitialState = true;
+
+    PendingEvent event;
+    event.type = Trace::CurrentDesktopChangedEvent;
+    event.value = m_wm->currentDesktop();
+    recordEvent(event);
+
+    event.type = Trace::CurrentActivityChangedEvent;
+    event.value = m_wm->currentActivity();
+    recordEvent(event);
+
+    event.type = Trace::WindowAddedEvent;
+    for (const auto &wid : m_wm->windowsTracker()->windows()) {
+        event.wid = wid;
+        recordEvent(event);
+    }
+
+    event.type = Trace::ActiveWindowChangedEvent;
+    event.wid = m_wm->activeWindow();
+    recordEvent(event);
+}
+
+void TraceRecorder::recordPendingEvents(int count)
+{
+    count = qMin(count, m_pendingEvents.count());
+
+    for (int i=0; i<count; ++i) {
+        recordEvent(m_pendingEvents[i]);
+    }
+
+    m_pendingEvents.erase(m_pendingEvents.begin(), m_pendingEvents.begin() + count);
+}
+
+void TraceRecorder::recordEvent(const PendingEvent &event)
+{
+    m_recordedEvents++;
+    m_stream << static_cast<quint8>(event.type) << event.time;
+
+    switch (event.type) {
+    case Trace::WindowAddedEvent:
+    case Trace::WindowChangedEvent: {
+        //! the complete window information is recorded because the replay has no other way
+        //! to retrieve it, the changed properties are recorded separately
+        WindowInfoWrap winfo = m_wm->windowsTracker()->infoFor(event.wid);
+        winfo.setWid(event.wid);
+
+        if (event.type == Trace::WindowChangedEvent) {
+            m_stream << static_cast<quint8>(int(event.properties));
+        }
+
+        m_stream << winfo;
+        break;
+    }
+    case Trace::WindowRemovedEvent:
+    case Trace::ActiveWindowChangedEvent:
+        m_stream << static_cast<quint64>(event.wid.toULongLong());
+        break;
+    case Trace::CurrentDesktopChangedEvent:
+    case Trace::CurrentActivityChangedEvent:
+        m_stream << event.value;
+        break;
+    }
+}
+
+}
+}
@@ -0,0 +1,127 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+// local
+#include "windowinfowrap.h"
+
+// Qt
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QObject>
+
+namespace Latte {
+namespace WindowSystem {
+class AbstractWindowInterface;
+}
+}
+
+namespace Latte {
+namespace WindowSystem {
+namespace Trace {
+
+//! "LTWT", Latte windows trace
+const quint32 MAGIC = 0x4C545754;
+const quint16 VERSION = 1;
+const int STREAMVERSION = QDataStream::Qt_5_9;
+
+//! Trace file format, after the header [MAGIC, VERSION] every record starts with
+//! [quint8 EventType, quint32 milliseconds since recording started] and follows with:
+//! WindowAddedEvent: WindowInfoWrap
+//! WindowChangedEvent: quint8 WindowProperties, WindowInfoWrap
+//! WindowRemovedEvent, ActiveWindowChangedEvent: quint64 window id
+//! CurrentDesktopChangedEvent, CurrentActivityChangedEvent: QString
+enum EventType
+{
+    WindowAddedEvent = 0,
+    WindowChangedEvent,
+    WindowRemovedEvent,
+    ActiveWindowChangedEvent,
+    CurrentDesktopChangedEvent,
+    CurrentActivityChangedEvent
+};
+
+}
+
+//! Records the window system events of a window interface into a trace file,
+//! the initial state of the tracked windows is recorded first. Events are kept
+//! until the windows tracker finishes the batch they belong to and they are
+//! recorded with the window information the tracker received for that batch,
+//! so the recording does not request any window information by itself
+class TraceRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    TraceRecorder(AbstractWindowInterface *parent);
+    ~TraceRecorder() override;
+
+    bool start(const QString &file);
+    void stop();
+
+    bool isRecording() const;
+
+    int recordedEvents() const;
+
+private slots:
+    void onEventsBatchStarted();
+    void onEventsBatchFinished();
+
+private:
+    struct PendingEvent
+    {
+        Trace::EventType type{Trace::WindowAddedEvent};
+        quint32 time{0};
+        WindowId wid;
+        WindowProperties properties{AllWindowProperties};
+        QString value;
+    };
+
+    void addEvent(const Trace::EventType &type, const WindowId &wid, const WindowProperties &properties = AllWindowProperties, const QString &value = QString());
+
+    void recordInitialState();
+    void recordEvent(const PendingEvent &event);
+    void recordPendingEvents(int count);
+
+private:
+    //! the initial state is recorded only when the tracker has no pending events,
+    //! otherwise the tracked windows would not contain them yet
+    bool m_hasInitialState{false};
+
+    int m_recordedEvents{0};
+    //! pending events that belong to the batch the tracker is evaluating
+    int m_batchedEvents{0};
+
+    QList<PendingEvent> m_pendingEvents;
+
+    QElapsedTimer m_timer;
+    QFile m_file;
+    QDataStream m_stream;
+
+    AbstractWindowInterface *m_wm{nullptr};
+};
+
+}
+}
+
+#endif
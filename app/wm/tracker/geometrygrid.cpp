@@ -0,0 +1,162 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "geometrygrid.h"
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+const int MAXCELLSPERWINDOW = 1024;
+
+GeometryGrid::GeometryGrid(const int &cellSize)
+    : m_cellSize(qMax(1, cellSize))
+{
+}
+
+int GeometryGrid::cellFor(const int &coordinate) const
+{
+    //! floor division in order to support also negative coordinates
+    if (coordinate >= 0) {
+        return coordinate / m_cellSize;
+    }
+
+    return -((-coordinate + m_cellSize - 1) / m_cellSize);
+}
+
+quint64 GeometryGrid::cellKey(const int &cellX, const int &cellY) const
+{
+    return (static_cast<quint64>(static_cast<quint32>(cellX)) << 32) | static_cast<quint32>(cellY);
+}
+
+QRect GeometryGrid::cellsFor(const QRect &geometry) const
+{
+    QRect normalized = geometry.normalized();
+
+    return QRect(QPoint(cellFor(normalized.left()), cellFor(normalized.top())),
+                 QPoint(cellFor(normalized.right()), cellFor(normalized.bottom())));
+}
+
+void GeometryGrid::insert(const WindowId &wid, const QRect &geometry)
+{
+    WindowKey key(wid);
+    QRect cells = geometry.isValid() ? cellsFor(geometry) : QRect();
+
+    if (m_windowCells.contains(key)) {
+        if (m_windowCells[key] == cells) {
+            //! window is still covering the same cells
+            return;
+        }
+
+        remove(wid);
+    }
+
+    m_windowCells[key] = cells;
+
+    if (cells.isEmpty()) {
+        return;
+    }
+
+    if (((qint64)cells.width() * cells.height()) > MAXCELLSPERWINDOW) {
+        m_oversizedWindows << key;
+        return;
+    }
+
+    for (int x = cells.left(); x <= cells.right(); ++x) {
+        for (int y = cells.top(); y <= cells.bottom(); ++y) {
+            m_cells[cellKey(x, y)] << key;
+        }
+    }
+}
+
+void GeometryGrid::remove(const WindowId &wid)
+{
+    WindowKey key(wid);
+
+    if (!m_windowCells.contains(key)) {
+        return;
+    }
+
+    QRect cells = m_windowCells.take(key);
+
+    if (m_oversizedWindows.contains(key)) {
+        m_oversizedWindows.removeAll(key);
+        return;
+    }
+
+    if (cells.isEmpty()) {
+        return;
+    }
+
+    for (int x = cells.left(); x <= cells.right(); ++x) {
+        for (int y = cells.top(); y <= cells.bottom(); ++y) {
+            quint64 cell = cellKey(x, y);
+
+            if (m_cells.contains(cell)) {
+                m_cells[cell].removeAll(key);
+
+                if (m_cells[cell].isEmpty()) {
+                    m_cells.remove(cell);
+                }
+            }
+        }
+    }
+}
+
+void GeometryGrid::clear()
+{
+    m_cells.clear();
+    m_windowCells.clear();
+    m_oversizedWindows.clear();
+}
+
+QList<WindowId> GeometryGrid::windows(const QRect &rect) const
+{
+    QList<WindowKey> candidates = m_oversizedWindows;
+
+    QRect cells = rect.isValid() ? cellsFor(rect) : QRect();
+
+    for (int x = cells.left(); x <= cells.right(); ++x) {
+        for (int y = cells.top(); y <= cells.bottom(); ++y) {
+            auto cell = m_cells.constFind(cellKey(x, y));
+
+            if (cell == m_cells.constEnd()) {
+                continue;
+            }
+
+            for (const auto &key : cell.value()) {
+                if (!candidates.contains(key)) {
+                    candidates << key;
+                }
+            }
+        }
+    }
+
+    QList<WindowId> wids;
+
+    for (const auto &key : candidates) {
+        wids << key.toWindowId();
+    }
+
+    return wids;
+}
+
+}
+}
+}
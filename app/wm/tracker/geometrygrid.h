@@ -0,0 +1,75 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMTRACKERGEOMETRYGRID_H
+#define WINDOWSYSTEMTRACKERGEOMETRYGRID_H
+
+// local
+#include "../windowinfowrap.h"
+
+// Qt
+#include <QHash>
+#include <QList>
+#include <QRect>
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! Uniform grid of windows geometries. Each window is registered in all the grid cells
+//! that its geometry covers, so geometry queries for a specific area, e.g. a view strip,
+//! check only the windows that are really close to that area
+class GeometryGrid
+{
+public:
+    GeometryGrid(const int &cellSize = 256);
+
+    void insert(const WindowId &wid, const QRect &geometry);
+    void remove(const WindowId &wid);
+    void clear();
+
+    //! windows whose geometry may intersect the given rect, they are only candidates
+    //! and each caller must still apply its own geometry criteria
+    QList<WindowId> windows(const QRect &rect) const;
+
+private:
+    QRect cellsFor(const QRect &geometry) const;
+    int cellFor(const int &coordinate) const;
+
+    quint64 cellKey(const int &cellX, const int &cellY) const;
+
+private:
+    int m_cellSize{256};
+
+    //! cell key and the windows that are covering it
+    QHash<quint64, QList<WindowKey>> m_cells;
+
+    //! window and the cells area that its geometry is covering
+    QHash<WindowKey, QRect> m_windowCells;
+
+    //! windows that cover too many cells, e.g. broken geometries, are not added
+    //! in cells but they are always returned as candidates
+    QList<WindowKey> m_oversizedWindows;
+};
+
+}
+}
+}
+
+#endif
@@ -32,6 +32,7 @@
 #include <QHoverEvent>
 #include <QPoint>
 #include <QTimer>
+#include <QtAlgorithms>
 
 
 namespace Latte {
@@ -42,6 +43,11 @@ const int INVALIDWID = -1;
 const int PREFHISTORY = 8;
 const int MAXHISTORY = 15;
 
+//! fields that are evaluated from each window information update
+const LastActiveWindow::Fields INFORMATIONFIELDS = LastActiveWindow::AllFields
+        & ~(LastActiveWindow::IsFullScreenField | LastActiveWindow::IsShadedField
+            | LastActiveWindow::HasSkipTaskbarField | LastActiveWindow::ColorSchemeField);
+
 LastActiveWindow::LastActiveWindow(TrackedGeneralInfo *trackedInfo)
     : QObject(trackedInfo),
       m_trackedInfo(trackedInfo),
@@ -75,7 +81,7 @@ void LastActiveWindow::setActive(bool active)
     }
 
     m_isActive = active;
-    emit isActiveChanged();
+    notifyChanged(IsActiveField);
 }
 
 bool LastActiveWindow::isMinimized() const
@@ -90,7 +96,7 @@ void LastActiveWindow::setIsMinimized(bool minimized)
     }
 
     m_isMinimized = minimized;
-    emit isMinimizedChanged();
+    notifyChanged(IsMinimizedField);
 }
 
 bool LastActiveWindow::isMaximized() const
@@ -105,7 +111,7 @@ void LastActiveWindow::setIsMaximized(bool maximized)
     }
 
     m_isMaximized = maximized;
-    emit isMaximizedChanged();
+    notifyChanged(IsMaximizedField);
 }
 
 bool LastActiveWindow::isFullScreen() const
@@ -120,7 +126,7 @@ void LastActiveWindow::setIsFullScreen(bool fullscreen)
     }
 
     m_isFullScreen = fullscreen;
-    emit isFullScreenChanged();
+    notifyChanged(IsFullScreenField);
 }
 
 bool LastActiveWindow::isKeepAbove() const
@@ -135,7 +141,7 @@ void LastActiveWindow::setIsKeepAbove(bool above)
     }
 
     m_isKeepAbove = above;
-    emit isKeepAboveChanged();
+    notifyChanged(IsKeepAboveField);
 }
 
 bool LastActiveWindow::isOnAllDesktops() const
@@ -150,7 +156,7 @@ void LastActiveWindow::setIsOnAllDesktops(bool all)
     }
 
     m_isOnAllDesktops = all;
-    emit isOnAllDesktopsChanged();
+    notifyChanged(IsOnAllDesktopsField);
 }
 
 bool LastActiveWindow::isShaded() const
@@ -165,7 +171,7 @@ void LastActiveWindow::setIsShaded(bool shaded)
     }
 
     m_isShaded = shaded;
-    emit isShadedChanged();
+    notifyChanged(IsShadedField);
 }
 
 bool LastActiveWindow::isValid() const
@@ -180,7 +186,7 @@ void LastActiveWindow::setIsValid(bool valid)
     }
 
     m_isValid = valid;
-    emit isValidChanged();
+    notifyChanged(IsValidField);
 }
 
 bool LastActiveWindow::hasSkipTaskbar() const
@@ -195,7 +201,7 @@ void LastActiveWindow::setHasSkipTaskbar(bool skip)
     }
 
     m_hasSkipTaskbar = skip;
-    emit hasSkipTaskbarChanged();
+    notifyChanged(HasSkipTaskbarField);
 }
 
 //! BEGIN: Window Abitilities
@@ -211,7 +217,7 @@ void LastActiveWindow::setIsClosable(bool closable)
     }
 
     m_isClosable = closable;
-    emit isClosableChanged();
+    notifyChanged(IsClosableField);
 }
 
 bool LastActiveWindow::isFullScreenable() const
@@ -226,7 +232,7 @@ void LastActiveWindow::setIsFullScreenable(bool fullscreenable)
     }
 
     m_isFullScreenable = fullscreenable;
-    emit isFullScreenableChanged();
+    notifyChanged(IsFullScreenableField);
 }
 
 bool LastActiveWindow::isGroupable() const
@@ -241,7 +247,7 @@ void LastActiveWindow::setIsGroupable(bool groupable)
     }
 
     m_isGroupable = groupable;
-    emit isGroupableChanged();
+    notifyChanged(IsGroupableField);
 }
 
 
@@ -257,7 +263,7 @@ void LastActiveWindow::setIsMaximizable(bool maximizable)
     }
 
     m_isMaximizable = maximizable;
-    emit isMaximizableChanged();
+    notifyChanged(IsMaximizableField);
 }
 
 bool LastActiveWindow::isMinimizable() const
@@ -272,7 +278,7 @@ void LastActiveWindow::setIsMinimizable(bool minimizable)
     }
 
     m_isMinimizable = minimizable;
-    emit isMinimizableChanged();
+    notifyChanged(IsMinimizableField);
 }
 
 bool LastActiveWindow::isMovable() const
@@ -287,7 +293,7 @@ void LastActiveWindow::setIsMovable(bool movable)
     }
 
     m_isMovable = movable;
-    emit isMovableChanged();
+    notifyChanged(IsMovableField);
 }
 
 bool LastActiveWindow::isResizable() const
@@ -302,7 +308,7 @@ void LastActiveWindow::setIsResizable(bool resizable)
     }
 
     m_isResizable = resizable;
-    emit isResizableChanged();
+    notifyChanged(IsResizableField);
 }
 
 bool LastActiveWindow::isShadeable() const
@@ -317,7 +323,7 @@ void LastActiveWindow::setIsShadeable(bool shadeable)
     }
 
     m_isShadeable = shadeable;
-    emit isShadeableChanged();
+    notifyChanged(IsShadeableField);
 }
 
 bool LastActiveWindow::isVirtualDesktopChangeable() const
@@ -332,7 +338,7 @@ void LastActiveWindow::setIsVirtualDesktopsChangeable(bool virtualdestkopschange
     }
 
     m_isVirtualDesktopsChangeable = virtualdestkopschangeable;
-    emit isVirtualDesktopChangeableChanged();
+    notifyChanged(IsVirtualDesktopChangeableField);
 }
 //! END: Window Abitilities
 
@@ -349,7 +355,7 @@ void LastActiveWindow::setGeometry(QRect geometry)
     }
 
     m_geometry = geometry;
-    emit geometryChanged();
+    notifyChanged(GeometryField);
 }
 
 QString LastActiveWindow::appName() const
@@ -364,7 +370,7 @@ void LastActiveWindow::setAppName(QString appName)
     }
 
     m_appName = appName;
-    emit appNameChanged();
+    notifyChanged(AppNameField);
 }
 
 QString LastActiveWindow::colorScheme() const
@@ -379,7 +385,7 @@ void LastActiveWindow::setColorScheme(QString scheme)
     }
 
     m_colorScheme = scheme;
-    emit colorSchemeChanged();
+    notifyChanged(ColorSchemeField);
 }
 
 QString LastActiveWindow::display() const
@@ -394,7 +400,7 @@ void LastActiveWindow::setDisplay(QString display)
     }
 
     m_display = display;
-    emit displayChanged();
+    notifyChanged(DisplayField);
 }
 
 QIcon LastActiveWindow::icon() const
@@ -404,8 +410,12 @@ QIcon LastActiveWindow::icon() const
 
 void LastActiveWindow::setIcon(QIcon icon)
 {
+    if (!m_icon.isNull() && m_icon.cacheKey() == icon.cacheKey()) {
+        return;
+    }
+
     m_icon = icon;
-    emit iconChanged();
+    notifyChanged(IconField);
 }
 
 QVariant LastActiveWindow::winId() const
@@ -429,7 +439,7 @@ void LastActiveWindow::setWinId(QVariant winId)
     }
 
     m_winId = winId;
-    emit winIdChanged();
+    notifyChanged(WinIdField);
 }
 
 void LastActiveWindow::setInformation(const WindowInfoWrap &info)
@@ -449,6 +459,11 @@ void LastActiveWindow::setInformation(const WindowInfoWrap &info)
         firstActiveness = true;
     }
 
+    //! changes are collected and their notifications are sent only for the fields
+    //! that really changed, followed by a single aggregated informationChanged()
+    m_pendingFields = NoField;
+    m_collectingChanges = true;
+
     setWinId(info.wid());
 
     setIsValid(true);
@@ -469,26 +484,151 @@ void LastActiveWindow::setInformation(const WindowInfoWrap &info)
     setIsVirtualDesktopsChangeable(info.isVirtualDesktopsChangeable());
     //! Window Abilities
 
-    setAppName(info.appName());
+    setAppName(info.appName().isEmpty() ? m_windowsTracker->appNameFor(info.wid()) : info.appName());
     setDisplay(info.display());
     setGeometry(info.geometry());
     setIsKeepAbove(info.isKeepAbove());
+    setIcon(info.icon().isNull() ? m_windowsTracker->iconFor(info.wid()) : info.icon());
+
+    Fields evaluatedFields = INFORMATIONFIELDS;
 
     if (firstActiveness) {
+        evaluatedFields |= ColorSchemeField;
         updateColorScheme();
     }
 
-    if (info.appName().isEmpty()) {
-        setAppName(m_windowsTracker->appNameFor(info.wid()));
-    } else {
-        setAppName(info.appName());
+    m_collectingChanges = false;
+
+    Fields changedFields = m_pendingFields;
+    m_pendingFields = NoField;
+
+    int changedCount = qPopulationCount(uint(changedFields));
+    int suppressedCount = qPopulationCount(uint(evaluatedFields & ~changedFields));
+
+    m_suppressedEmissions += suppressedCount;
+    m_windowsTracker->addLastActiveWindowUpdate(changedCount, suppressedCount);
+
+    emitChanges(changedFields);
+}
+
+void LastActiveWindow::notifyChanged(const Field &field)
+{
+    if (m_collectingChanges) {
+        m_pendingFields |= field;
+        return;
     }
 
-    if (info.icon().isNull()) {
-        setIcon(m_windowsTracker->iconFor(info.wid()));
-    } else {
-        setIcon(info.icon());
+    emitChanges(field);
+}
+
+void LastActiveWindow::emitChanges(const Fields &fields)
+{
+    if (!fields) {
+        return;
+    }
+
+    if (fields & WinIdField) {
+        emit winIdChanged();
+    }
+
+    if (fields & IsValidField) {
+        emit isValidChanged();
+    }
+
+    if (fields & IsActiveField) {
+        emit isActiveChanged();
+    }
+
+    if (fields & IsMinimizedField) {
+        emit isMinimizedChanged();
+    }
+
+    if (fields & IsMaximizedField) {
+        emit isMaximizedChanged();
+    }
+
+    if (fields & IsFullScreenField) {
+        emit isFullScreenChanged();
+    }
+
+    if (fields & IsKeepAboveField) {
+        emit isKeepAboveChanged();
+    }
+
+    if (fields & IsOnAllDesktopsField) {
+        emit isOnAllDesktopsChanged();
     }
+
+    if (fields & IsShadedField) {
+        emit isShadedChanged();
+    }
+
+    if (fields & HasSkipTaskbarField) {
+        emit hasSkipTaskbarChanged();
+    }
+
+    if (fields & IsClosableField) {
+        emit isClosableChanged();
+    }
+
+    if (fields & IsFullScreenableField) {
+        emit isFullScreenableChanged();
+    }
+
+    if (fields & IsGroupableField) {
+        emit isGroupableChanged();
+    }
+
+    if (fields & IsMaximizableField) {
+        emit isMaximizableChanged();
+    }
+
+    if (fields & IsMinimizableField) {
+        emit isMinimizableChanged();
+    }
+
+    if (fields & IsMovableField) {
+        emit isMovableChanged();
+    }
+
+    if (fields & IsResizableField) {
+        emit isResizableChanged();
+    }
+
+    if (fields & IsShadeableField) {
+        emit isShadeableChanged();
+    }
+
+    if (fields & IsVirtualDesktopChangeableField) {
+        emit isVirtualDesktopChangeableChanged();
+    }
+
+    if (fields & ColorSchemeField) {
+        emit colorSchemeChanged();
+    }
+
+    if (fields & AppNameField) {
+        emit appNameChanged();
+    }
+
+    if (fields & DisplayField) {
+        emit displayChanged();
+    }
+
+    if (fields & GeometryField) {
+        emit geometryChanged();
+    }
+
+    if (fields & IconField) {
+        emit iconChanged();
+    }
+
+    emit informationChanged(fields);
+}
+
+int LastActiveWindow::suppressedEmissions() const
+{
+    return m_suppressedEmissions;
 }
 
 //! PRIVATE SLOTS
@@ -81,6 +81,40 @@ class LastActiveWindow : public QObject {
     Q_PROPERTY(QVariant winId READ winId NOTIFY winIdChanged)
 
 public:
+    //! fields of the window information, used to inform with one
+    //! notification which of them changed from an information update
+    enum Field
+    {
+        NoField = 0,
+        IsValidField = 1 << 0,
+        IsActiveField = 1 << 1,
+        IsMinimizedField = 1 << 2,
+        IsMaximizedField = 1 << 3,
+        IsFullScreenField = 1 << 4,
+        IsKeepAboveField = 1 << 5,
+        IsOnAllDesktopsField = 1 << 6,
+        IsShadedField = 1 << 7,
+        HasSkipTaskbarField = 1 << 8,
+        IsClosableField = 1 << 9,
+        IsFullScreenableField = 1 << 10,
+        IsGroupableField = 1 << 11,
+        IsMaximizableField = 1 << 12,
+        IsMinimizableField = 1 << 13,
+        IsMovableField = 1 << 14,
+        IsResizableField = 1 << 15,
+        IsShadeableField = 1 << 16,
+        IsVirtualDesktopChangeableField = 1 << 17,
+        ColorSchemeField = 1 << 18,
+        AppNameField = 1 << 19,
+        DisplayField = 1 << 20,
+        GeometryField = 1 << 21,
+        IconField = 1 << 22,
+        WinIdField = 1 << 23,
+        AllFields = (1 << 24) - 1
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
+    Q_FLAG(Fields)
+
     LastActiveWindow(TrackedGeneralInfo *trackedInfo);
     ~LastActiveWindow() override;
 
@@ -118,6 +152,9 @@ public:
 
     void setInformation(const WindowInfoWrap &info);
 
+    //! field notifications that were not sent because their value did not change
+    int suppressedEmissions() const;
+
 public slots:
     Q_INVOKABLE void requestActivate();
     Q_INVOKABLE void requestClose();
@@ -169,6 +206,9 @@ signals:
     void geometryChanged();
     void winIdChanged();
 
+    //! sent once after the individual notifications of an information update
+    void informationChanged(Latte::WindowSystem::Tracker::LastActiveWindow::Fields changedFields);
+
 private:
     void setActive(bool active);
     void setIsMinimized(bool minimized);
@@ -206,6 +246,9 @@ private:
     void cleanHistory();
     void updateColorScheme();
 
+    void notifyChanged(const Field &field);
+    void emitChanges(const Fields &fields);
+
 private:
     bool m_isActive{false};
     bool m_isMinimized{false};
@@ -242,6 +285,10 @@ private:
 
     QList<WindowId> m_history;
 
+    bool m_collectingChanges{false};
+    Fields m_pendingFields{NoField};
+    int m_suppressedEmissions{0};
+
     TrackedGeneralInfo *m_trackedInfo{nullptr};
     AbstractWindowInterface *m_wm{nullptr};
     Tracker::Windows *m_windowsTracker{nullptr};
@@ -251,4 +298,6 @@ private:
 }
 }
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(Latte::WindowSystem::Tracker::LastActiveWindow::Fields)
+
 #endif
@@ -20,20 +20,25 @@
 #include "schemes.h"
 
 // local
+#include "windowstracker.h"
 #include "../abstractwindowinterface.h"
 #include "../../lattecorona.h"
+#include "../../tools/filewatcher.h"
 
 // Qt
 #include <QDir>
-
-// KDE
-#include <KDirWatch>
+#include <QFileInfo>
 
 
 namespace Latte {
 namespace WindowSystem {
 namespace Tracker {
 
+//! schemes that are not used from any window are kept for fast window scheme switches
+const int UNUSEDSCHEMESLIMIT = 4;
+//! unused schemes are evicted in batches after that interval
+const int SCHEMESEVICTIONINTERVAL = 5000;
+
 Schemes::Schemes(AbstractWindowInterface *parent)
     : QObject(parent)
 {
@@ -44,14 +49,16 @@ Schemes::Schemes(AbstractWindowInterface *parent)
 Schemes::~Schemes()
 {
     m_windowScheme.clear();
-    //! it is just a reference to a real scheme file
-    m_schemes.take("kdeglobals");
     qDeleteAll(m_schemes);
     m_schemes.clear();
 }
 
 void Schemes::init()
 {
+    m_evictionTimer.setSingleShot(true);
+    m_evictionTimer.setInterval(SCHEMESEVICTIONINTERVAL);
+    connect(&m_evictionTimer, &QTimer::timeout, this, &Schemes::evictUnusedSchemes);
+
     updateDefaultScheme();
 
     connect(this, &Schemes::colorSchemeChanged, this, [&](WindowId wid) {
@@ -61,78 +68,179 @@ void Schemes::init()
     });
 
     connect(m_wm, &AbstractWindowInterface::windowRemoved, this, [&](WindowId wid) {
-        m_windowScheme.remove(wid);
+        WindowKey key(wid);
+
+        if (m_windowScheme.contains(key)) {
+            releaseScheme(m_windowScheme.take(key));
+        }
     });
 
     //! track for changing default scheme
     QString kdeSettingsFile = QDir::homePath() + "/.config/kdeglobals";
 
-    KDirWatch::self()->addFile(kdeSettingsFile);
+    FileWatcher::self()->watchFile(kdeSettingsFile, this, [&](const QString &) {
+        updateDefaultScheme();
+    });
+}
+
+QString Schemes::schemeFile(const QString &scheme)
+{
+    if (m_schemeFiles.contains(scheme)) {
+        return m_schemeFiles[scheme];
+    }
+
+    QString file = SchemeColors::possibleSchemeFile(scheme);
+
+    if (file.isEmpty()) {
+        //! the scheme may be installed afterwards, so it is not cached
+        return file;
+    }
+
+    //! the same scheme can be requested through different names and symlinks
+    QString canonicalFile = QFileInfo(file).canonicalFilePath();
+
+    if (canonicalFile.isEmpty()) {
+        canonicalFile = file;
+    }
+
+    m_schemeFiles[scheme] = canonicalFile;
+
+    return canonicalFile;
+}
+
+SchemeColors *Schemes::scheme(const QString &schemeFile)
+{
+    if (!m_schemes.contains(schemeFile)) {
+        //! when this scheme file has not been loaded yet
+        m_schemes[schemeFile] = new SchemeColors(this, schemeFile);
+    }
+
+    return m_schemes[schemeFile];
+}
+
+void Schemes::retainScheme(const QString &schemeFile)
+{
+    m_schemeWindows[schemeFile]++;
+    m_unusedSchemes.removeAll(schemeFile);
+}
+
+void Schemes::releaseScheme(const QString &schemeFile)
+{
+    if (!m_schemeWindows.contains(schemeFile)) {
+        return;
+    }
+
+    if (--m_schemeWindows[schemeFile] > 0) {
+        return;
+    }
+
+    m_schemeWindows.remove(schemeFile);
+    m_unusedSchemes.prepend(schemeFile);
 
-    connect(KDirWatch::self(), &KDirWatch::dirty, this, [ &, kdeSettingsFile](const QString & path) {
-        if (path == kdeSettingsFile) {
-            this->updateDefaultScheme();
+    if (m_unusedSchemes.count() > UNUSEDSCHEMESLIMIT) {
+        m_evictionTimer.start();
+    }
+}
+
+void Schemes::evictUnusedSchemes()
+{
+    bool skipped{false};
+
+    //! least recently used schemes are evicted first
+    for (int i = m_unusedSchemes.count() - 1; i >= 0 && m_unusedSchemes.count() > UNUSEDSCHEMESLIMIT; --i) {
+        QString schemeFile = m_unusedSchemes[i];
+        SchemeColors *colors = m_schemes.value(schemeFile, nullptr);
+
+        if (colors == m_defaultScheme) {
+            m_unusedSchemes.removeAt(i);
+            continue;
         }
-    });
 
-    connect(KDirWatch::self(), &KDirWatch::created, this, [ &, kdeSettingsFile](const QString & path) {
-        if (path == kdeSettingsFile) {
-            this->updateDefaultScheme();
+        //! views and layouts that are not tracking the current activity are not re-evaluated
+        //! and may still reference a scheme that no window uses any more
+        //! they are retried at the next eviction
+        if (colors && m_wm->windowsTracker()->isSchemeInUse(colors)) {
+            skipped = true;
+            continue;
         }
-    });
+
+        m_unusedSchemes.removeAt(i);
+
+        if (colors) {
+            m_schemes.take(schemeFile)->deleteLater();
+        }
+    }
+
+    if (skipped && m_unusedSchemes.count() > UNUSEDSCHEMESLIMIT) {
+        m_evictionTimer.start();
+    }
 }
 
 //! Scheme support for windows
 void Schemes::updateDefaultScheme()
 {
-    QString defaultSchemePath = SchemeColors::possibleSchemeFile("kdeglobals");
+    //! kdeglobals points to a different scheme file when the default scheme changes
+    m_schemeFiles.remove("kdeglobals");
+    QString defaultSchemePath = schemeFile("kdeglobals");
 
     qDebug() << " Windows default color scheme :: " << defaultSchemePath;
 
-    SchemeColors *dScheme;
+    SchemeColors *dScheme = scheme(defaultSchemePath);
 
-    if (!m_schemes.contains(defaultSchemePath)) {
-        dScheme = new SchemeColors(this, defaultSchemePath);
-        m_schemes[defaultSchemePath] = dScheme;
-    } else {
-        dScheme = m_schemes[defaultSchemePath];
+    if (m_defaultScheme == dScheme) {
+        return;
     }
 
-    if (!m_schemes.contains("kdeglobals") || m_schemes["kdeglobals"]->schemeFile() != defaultSchemePath) {
-        m_schemes["kdeglobals"] = dScheme;
+    if (m_defaultScheme && !m_schemeWindows.contains(m_defaultScheme->schemeFile())) {
+        //! previous default scheme is not used from any window any more
+        m_unusedSchemes.removeAll(m_defaultScheme->schemeFile());
+        m_unusedSchemes.prepend(m_defaultScheme->schemeFile());
+        m_evictionTimer.start();
     }
+
+    m_defaultScheme = dScheme;
+    m_unusedSchemes.removeAll(defaultSchemePath);
 }
 
 SchemeColors *Schemes::schemeForWindow(WindowId wid)
 {
-    if (!m_windowScheme.contains(wid)) {
-        return m_schemes["kdeglobals"];
-    } else {
-        return m_schemes[m_windowScheme[wid]];
+    WindowKey key(wid);
+
+    if (!m_windowScheme.contains(key)) {
+        return m_defaultScheme;
     }
 
-    return nullptr;
+    return m_schemes.value(m_windowScheme[key], m_defaultScheme);
 }
 
 void Schemes::setColorSchemeForWindow(WindowId wid, QString scheme)
 {
-    if (scheme == "kdeglobals" && !m_windowScheme.contains(wid)) {
+    WindowKey key(wid);
+
+    //! schemes whose file can not be found fall back to the default scheme
+    QString file = (scheme == "kdeglobals") ? QString() : schemeFile(scheme);
+
+    if (file.isEmpty() && !m_windowScheme.contains(key)) {
         //default scheme does not have to be set
         return;
     }
 
-    if (scheme == "kdeglobals") {
+    if (file.isEmpty()) {
         //! a window that previously had an explicit set scheme now is set back to default scheme
-        m_windowScheme.remove(wid);
+        releaseScheme(m_windowScheme.take(key));
     } else {
-        QString schemeFile = SchemeColors::possibleSchemeFile(scheme);
+        if (m_windowScheme.contains(key) && m_windowScheme[key] == file) {
+            return;
+        }
+
+        this->scheme(file);
+        retainScheme(file);
 
-        if (!m_schemes.contains(schemeFile)) {
-            //! when this scheme file has not been loaded yet
-            m_schemes[schemeFile] = new SchemeColors(this, schemeFile);
+        if (m_windowScheme.contains(key)) {
+            releaseScheme(m_windowScheme[key]);
         }
 
-        m_windowScheme[wid] = schemeFile;
+        m_windowScheme[key] = file;
     }
 
     emit colorSchemeChanged(wid);
@@ -24,7 +24,10 @@
 #include "../windowinfowrap.h"
 
 // Qt
+#include <QHash>
 #include <QObject>
+#include <QStringList>
+#include <QTimer>
 
 
 namespace Latte {
@@ -57,14 +60,32 @@ private slots:
 private:
     void init();
 
+    //! canonical scheme file for the provided scheme name or file
+    QString schemeFile(const QString &scheme);
+    SchemeColors *scheme(const QString &schemeFile);
+
+    void retainScheme(const QString &schemeFile);
+    void releaseScheme(const QString &schemeFile);
+    void evictUnusedSchemes();
+
 private:
      AbstractWindowInterface *m_wm;
 
-     //! scheme file and its loaded colors
-     QMap<QString, Latte::WindowSystem::SchemeColors *> m_schemes;
+     SchemeColors *m_defaultScheme{nullptr};
+
+     //! canonical scheme file and its colors, colors are loaded when they are requested
+     QHash<QString, Latte::WindowSystem::SchemeColors *> m_schemes;
+     //! scheme name and its canonical scheme file
+     QHash<QString, QString> m_schemeFiles;
+     //! canonical scheme file and the number of windows using it
+     QHash<QString, int> m_schemeWindows;
+     //! schemes that are not used from any window, most recently used first
+     QStringList m_unusedSchemes;
+
+     //! window id and its corresponding canonical scheme file
+     QHash<WindowKey, QString> m_windowScheme;
 
-     //! window id and its corresponding scheme file
-     QMap<WindowId, QString> m_windowScheme;
+     QTimer m_evictionTimer;
 };
 
 }
@@ -0,0 +1,231 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "statistics.h"
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! upper bounds of the histogram buckets in microseconds, the last bucket has no upper bound
+const QVector<int> HISTOGRAMBOUNDS{50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000};
+
+const char *EVENTNAMES[Statistics::EventTypesCount] = {
+    "windowAdded",
+    "windowChanged",
+    "windowRemoved",
+    "activeWindowChanged",
+    "currentDesktopChanged",
+    "currentActivityChanged"
+};
+
+Histogram::Histogram()
+{
+    reset();
+}
+
+void Histogram::add(qint64 nsecs)
+{
+    qint64 usecs = nsecs / 1000;
+    int bucket = 0;
+
+    while (bucket < HISTOGRAMBOUNDS.count() && usecs >= HISTOGRAMBOUNDS[bucket]) {
+        bucket++;
+    }
+
+    m_buckets[bucket]++;
+    m_count++;
+    m_total += nsecs;
+    m_max = qMax(m_max, nsecs);
+}
+
+void Histogram::reset()
+{
+    m_count = 0;
+    m_total = 0;
+    m_max = 0;
+    m_buckets.fill(0, HISTOGRAMBOUNDS.count() + 1);
+}
+
+int Histogram::count() const
+{
+    return m_count;
+}
+
+QStringList Histogram::toStringList(const QString &name) const
+{
+    QStringList buckets;
+
+    for (int i=0; i<m_buckets.count(); ++i) {
+        QString bound = i < HISTOGRAMBOUNDS.count() ? QStringLiteral("<%1").arg(HISTOGRAMBOUNDS[i])
+                                                    : QStringLiteral(">=%1").arg(HISTOGRAMBOUNDS.last());
+        buckets << QStringLiteral("%1:%2").arg(bound).arg(m_buckets[i]);
+    }
+
+    return QStringList{QStringLiteral("%1.count=%2").arg(name).arg(m_count),
+                       QStringLiteral("%1.avg_us=%2").arg(name).arg(m_count > 0 ? (m_total / m_count) / 1000 : 0),
+                       QStringLiteral("%1.max_us=%2").arg(name).arg(m_max / 1000),
+                       QStringLiteral("%1.histogram_us=%2").arg(name).arg(buckets.join(QStringLiteral(",")))};
+}
+
+Statistics::Statistics()
+{
+    reset();
+}
+
+void Statistics::addEvent(const EventType &type)
+{
+    m_events[type]++;
+}
+
+void Statistics::addCoalescedEvent()
+{
+    m_coalescedEvents++;
+}
+
+void Statistics::addViewHintsUpdate(uint viewId)
+{
+    m_viewHintsUpdates[viewId]++;
+}
+
+void Statistics::addLayoutHintsUpdate(const QString &layoutName)
+{
+    m_layoutHintsUpdates[layoutName]++;
+}
+
+void Statistics::addScannedWindow()
+{
+    m_scannedWindows++;
+}
+
+void Statistics::addHintsEvaluation()
+{
+    m_hintsEvaluations++;
+}
+
+void Statistics::addHintFlip()
+{
+    m_hintFlips++;
+}
+
+void Statistics::addBatchDuration(qint64 nsecs)
+{
+    m_batchDurations.add(nsecs);
+}
+
+void Statistics::addHintsPassDuration(qint64 nsecs)
+{
+    m_hintsPassDurations.add(nsecs);
+}
+
+void Statistics::addLastActiveWindowUpdate(int changedFields, int suppressedFields)
+{
+    m_lastActiveWindowUpdates++;
+    m_lastActiveWindowChangedFields += changedFields;
+    m_lastActiveWindowSuppressedFields += suppressedFields;
+}
+
+quint64 Statistics::receivedEvents() const
+{
+    quint64 events{0};
+
+    for (int i=0; i<EventTypesCount; ++i) {
+        events += m_events[i];
+    }
+
+    return events;
+}
+
+quint64 Statistics::coalescedEvents() const
+{
+    return m_coalescedEvents;
+}
+
+quint64 Statistics::scannedWindows() const
+{
+    return m_scannedWindows;
+}
+
+quint64 Statistics::hintsEvaluations() const
+{
+    return m_hintsEvaluations;
+}
+
+void Statistics::reset()
+{
+    for (int i=0; i<EventTypesCount; ++i) {
+        m_events[i] = 0;
+    }
+
+    m_coalescedEvents = 0;
+    m_scannedWindows = 0;
+    m_hintsEvaluations = 0;
+    m_hintFlips = 0;
+
+    m_lastActiveWindowUpdates = 0;
+    m_lastActiveWindowChangedFields = 0;
+    m_lastActiveWindowSuppressedFields = 0;
+
+    m_viewHintsUpdates.clear();
+    m_layoutHintsUpdates.clear();
+
+    m_batchDurations.reset();
+    m_hintsPassDurations.reset();
+
+    m_collectingTimer.start();
+}
+
+QStringList Statistics::toStringList() const
+{
+    QStringList entries;
+
+    entries << QStringLiteral("collecting_ms=%1").arg(m_collectingTimer.elapsed());
+
+    for (int i=0; i<EventTypesCount; ++i) {
+        entries << QStringLiteral("events.%1=%2").arg(QLatin1String(EVENTNAMES[i])).arg(m_events[i]);
+    }
+
+    entries << QStringLiteral("events.received=%1").arg(receivedEvents());
+    entries << QStringLiteral("events.coalesced=%1").arg(m_coalescedEvents);
+
+    for (auto it = m_viewHintsUpdates.constBegin(); it != m_viewHintsUpdates.constEnd(); ++it) {
+        entries << QStringLiteral("hints.updates.view.%1=%2").arg(it.key()).arg(it.value());
+    }
+
+    for (auto it = m_layoutHintsUpdates.constBegin(); it != m_layoutHintsUpdates.constEnd(); ++it) {
+        entries << QStringLiteral("hints.updates.layout.%1=%2").arg(it.key()).arg(it.value());
+    }
+
+    entries << QStringLiteral("hints.evaluations=%1").arg(m_hintsEvaluations);
+    entries << QStringLiteral("hints.flips=%1").arg(m_hintFlips);
+    entries << QStringLiteral("windows.scanned=%1").arg(m_scannedWindows);
+
+    entries << QStringLiteral("lastactivewindow.updates=%1").arg(m_lastActiveWindowUpdates);
+    entries << QStringLiteral("lastactivewindow.emitted=%1").arg(m_lastActiveWindowChangedFields);
+    entries << QStringLiteral("lastactivewindow.suppressed=%1").arg(m_lastActiveWindowSuppressedFields);
+
+    entries << m_batchDurations.toStringList(QStringLiteral("time.batch"));
+    entries << m_hintsPassDurations.toStringList(QStringLiteral("time.hintspass"));
+
+    return entries;
+}
+
+}
+}
+}
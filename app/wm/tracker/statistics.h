@@ -0,0 +1,123 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMTRACKERSTATISTICS_H
+#define WINDOWSYSTEMTRACKERSTATISTICS_H
+
+// Qt
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! latency histogram with fixed microseconds buckets
+class Histogram
+{
+public:
+    Histogram();
+
+    void add(qint64 nsecs);
+    void reset();
+
+    int count() const;
+
+    //! name.count, name.avg_us, name.max_us and name.histogram entries
+    QStringList toStringList(const QString &name) const;
+
+private:
+    int m_count{0};
+    qint64 m_total{0};
+    qint64 m_max{0};
+
+    QVector<int> m_buckets;
+};
+
+//! Runtime counters of the windows tracker, they are kept always because their cost is
+//! negligible compared to the tracking itself and they can be requested from D-Bus at any time
+class Statistics
+{
+public:
+    enum EventType
+    {
+        WindowAddedEvent = 0,
+        WindowChangedEvent,
+        WindowRemovedEvent,
+        ActiveWindowChangedEvent,
+        CurrentDesktopChangedEvent,
+        CurrentActivityChangedEvent,
+        EventTypesCount
+    };
+
+    Statistics();
+
+    void addEvent(const EventType &type);
+    void addCoalescedEvent();
+    void addViewHintsUpdate(uint viewId);
+    void addLayoutHintsUpdate(const QString &layoutName);
+    void addScannedWindow();
+    void addHintsEvaluation();
+    void addHintFlip();
+    void addBatchDuration(qint64 nsecs);
+    void addHintsPassDuration(qint64 nsecs);
+    void addLastActiveWindowUpdate(int changedFields, int suppressedFields);
+
+    quint64 receivedEvents() const;
+    quint64 coalescedEvents() const;
+    quint64 scannedWindows() const;
+    quint64 hintsEvaluations() const;
+
+    void reset();
+
+    //! "key=value" entries
+    QStringList toStringList() const;
+
+private:
+    //! the counters are never reset for a long running session, so they must not overflow
+    quint64 m_events[EventTypesCount];
+    quint64 m_coalescedEvents{0};
+    quint64 m_scannedWindows{0};
+    //! window hints computed for a single view or layout
+    quint64 m_hintsEvaluations{0};
+    quint64 m_hintFlips{0};
+
+    quint64 m_lastActiveWindowUpdates{0};
+    quint64 m_lastActiveWindowChangedFields{0};
+    quint64 m_lastActiveWindowSuppressedFields{0};
+
+    QHash<uint, quint64> m_viewHintsUpdates;
+    QHash<QString, quint64> m_layoutHintsUpdates;
+
+    //! from the batch processing until its consumers have been informed
+    Histogram m_batchDurations;
+    //! window hints evaluation for all views and layouts
+    Histogram m_hintsPassDurations;
+
+    QElapsedTimer m_collectingTimer;
+};
+
+}
+}
+}
+
+#endif
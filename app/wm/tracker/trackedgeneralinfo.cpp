@@ -117,9 +117,16 @@ bool TrackedGeneralInfo::isTrackingCurrentActivity() const
 
 void TrackedGeneralInfo::updateTrackingCurrentActivity()
 {
-    m_isTrackingCurrentActivity = ( m_activities.isEmpty()
-                                    || m_activities[0] == "0"
-            || m_activities.contains(m_wm->currentActivity()));
+    bool tracking = ( m_activities.isEmpty()
+                      || m_activities[0] == "0"
+                      || m_activities.contains(m_wm->currentActivity()));
+
+    if (m_isTrackingCurrentActivity == tracking) {
+        return;
+    }
+
+    m_isTrackingCurrentActivity = tracking;
+    emit isTrackingCurrentActivityChanged();
 }
 
 
@@ -161,6 +168,65 @@ bool TrackedGeneralInfo::isTracking(const WindowInfoWrap &winfo) const
             && winfo.isOnActivity(m_wm->currentActivity()));
 }
 
+TrackedGeneralInfo::WindowHints TrackedGeneralInfo::contribution(const WindowId &wid) const
+{
+    return m_contributions.value(wid, NoHint);
+}
+
+bool TrackedGeneralInfo::setContribution(const WindowId &wid, const WindowHints &hints)
+{
+    WindowHints previous = contribution(wid);
+
+    if (previous == hints) {
+        return false;
+    }
+
+    for (int i=0; i<HINTSCOUNT; ++i) {
+        WindowHint hint = static_cast<WindowHint>(1 << i);
+
+        if (previous.testFlag(hint)) {
+            m_contributors[i]--;
+        }
+
+        if (hints.testFlag(hint)) {
+            m_contributors[i]++;
+        }
+    }
+
+    if (hints == NoHint) {
+        m_contributions.remove(wid);
+    } else {
+        m_contributions[wid] = hints;
+    }
+
+    return true;
+}
+
+void TrackedGeneralInfo::clearContributions()
+{
+    for (int i=0; i<HINTSCOUNT; ++i) {
+        m_contributors[i] = 0;
+    }
+
+    m_contributions.clear();
+}
+
+int TrackedGeneralInfo::contributors(const WindowHint &hint) const
+{
+    for (int i=0; i<HINTSCOUNT; ++i) {
+        if (hint == (1 << i)) {
+            return m_contributors[i];
+        }
+    }
+
+    return 0;
+}
+
+const QMap<WindowId, TrackedGeneralInfo::WindowHints> &TrackedGeneralInfo::contributions() const
+{
+    return m_contributions;
+}
+
 }
 }
 }
@@ -25,6 +25,7 @@
 #include "../windowinfowrap.h"
 
 // Qt
+#include <QMap>
 #include <QObject>
 
 namespace Latte {
@@ -47,6 +48,19 @@ class TrackedGeneralInfo : public QObject {
     Q_PROPERTY(Latte::WindowSystem::Tracker::LastActiveWindow *activeWindow READ lastActiveWindow NOTIFY lastActiveWindowChanged)
 
 public:
+    //! hints that a single window provides to the tracked information,
+    //! they are stored per window in order to update tracking incrementally
+    enum WindowHint
+    {
+        NoHint = 0x00,
+        ActiveHint = 0x01,
+        ActiveInScreenHint = 0x02,
+        MaximizedHint = 0x04,
+        TouchingHint = 0x08,
+        TouchingEdgeHint = 0x10
+    };
+    Q_DECLARE_FLAGS(WindowHints, WindowHint)
+
     TrackedGeneralInfo(Tracker::Windows *tracker);
     ~TrackedGeneralInfo() override;
 
@@ -75,8 +89,20 @@ public:
 
     virtual bool isTracking(const WindowInfoWrap &winfo) const;
 
+    //! Windows contributions
+    WindowHints contribution(const WindowId &wid) const;
+    //! returns true when the window contribution was changed
+    bool setContribution(const WindowId &wid, const WindowHints &hints);
+    void clearContributions();
+
+    //! number of windows that are currently providing the specific hint
+    int contributors(const WindowHint &hint) const;
+    //! only windows that provide at least one hint are stored
+    const QMap<WindowId, WindowHints> &contributions() const;
+
 signals:
     void lastActiveWindowChanged();
+    void isTrackingCurrentActivityChanged();
 
 protected:
     void updateTrackingCurrentActivity();
@@ -89,16 +115,24 @@ protected:
     Tracker::Windows *m_tracker{nullptr};
 
 private:
-    bool m_enabled;
-    bool m_activeWindowMaximized;
-    bool m_existsWindowActive;
-    bool m_existsWindowMaximized;
+    bool m_enabled{false};
+    bool m_activeWindowMaximized{false};
+    bool m_existsWindowActive{false};
+    bool m_existsWindowMaximized{false};
 
     bool m_isTrackingCurrentActivity{true};
 
     SchemeColors *m_activeWindowScheme{nullptr};
+
+    //! aggregate counters of windows contributions, one counter for each WindowHint
+    static const int HINTSCOUNT = 5;
+    int m_contributors[HINTSCOUNT]{0, 0, 0, 0, 0};
+
+    QMap<WindowId, WindowHints> m_contributions;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(TrackedGeneralInfo::WindowHints)
+
 }
 }
 }
@@ -35,17 +35,94 @@ TrackedViewInfo::TrackedViewInfo(Tracker::Windows *tracker, Latte::View *view)
       m_view(view)
 {
     m_activities = m_view->activities();
+    m_absoluteGeometry = m_view->absoluteGeometry();
+    m_screenGeometry = m_view->screenGeometry();
+    m_location = m_view->location();
+    m_formFactor = m_view->formFactor();
 
     connect(m_view, &Latte::View::activitiesChanged, this, [&]() {
         m_activities = m_view->activities();
         updateTrackingCurrentActivity();
     });
+
+    connect(m_view, &Latte::View::absoluteGeometryChanged, this, [&](const QRect &geometry) {
+        m_absoluteGeometry = geometry;
+    });
+
+    connect(m_view, &Latte::View::screenGeometryChanged, this, [&]() {
+        m_screenGeometry = m_view->screenGeometry();
+    });
+
+    connect(m_view, &Latte::View::locationChanged, this, [&]() {
+        m_location = m_view->location();
+    });
+
+    connect(m_view, &Latte::View::formFactorChanged, this, [&]() {
+        m_formFactor = m_view->formFactor();
+    });
+}
+
+TrackedViewInfo::TrackedViewInfo(Tracker::Windows *tracker, const QRect &absoluteGeometry, const QRect &screenGeometry, const Plasma::Types::Location &location)
+    : TrackedGeneralInfo(tracker),
+      m_availableScreenGeometry(screenGeometry),
+      m_absoluteGeometry(absoluteGeometry),
+      m_screenGeometry(screenGeometry),
+      m_location(location)
+{
+    if (location == Plasma::Types::TopEdge || location == Plasma::Types::BottomEdge) {
+        m_formFactor = Plasma::Types::Horizontal;
+    } else if (location == Plasma::Types::LeftEdge || location == Plasma::Types::RightEdge) {
+        m_formFactor = Plasma::Types::Vertical;
+    }
+
+    setEnabled(true);
 }
 
 TrackedViewInfo::~TrackedViewInfo()
 {
 }
 
+TrackedViewInfo::ViewHints TrackedViewInfo::requestedHints() const
+{
+    return m_requestedHints;
+}
+
+void TrackedViewInfo::setRequestedHints(const ViewHints &hints)
+{
+    if (m_requestedHints == hints) {
+        return;
+    }
+
+    m_requestedHints = hints;
+}
+
+bool TrackedViewInfo::isRequested(const ViewHint &hint) const
+{
+    return m_requestedHints.testFlag(hint);
+}
+
+TrackedGeneralInfo::WindowHints TrackedViewInfo::requiredWindowHints() const
+{
+    //! active window in screen is always needed for LastActiveWindow
+    WindowHints hints = ActiveHint | ActiveInScreenHint;
+
+    //! active window maximized is identified through the active touching windows
+    //! and touching window scheme depends on all touching and maximized windows
+    if (m_requestedHints & (ActiveWindowMaximizedHint | ExistsWindowMaximizedHint | TouchingWindowSchemeHint)) {
+        hints |= MaximizedHint;
+    }
+
+    if (m_requestedHints & (ActiveWindowMaximizedHint | ActiveWindowTouchingHint | ExistsWindowTouchingHint | TouchingWindowSchemeHint)) {
+        hints |= TouchingHint;
+    }
+
+    if (m_requestedHints & (ActiveWindowMaximizedHint | ActiveWindowTouchingEdgeHint | ExistsWindowTouchingEdgeHint | TouchingWindowSchemeHint)) {
+        hints |= TouchingEdgeHint;
+    }
+
+    return hints;
+}
+
 bool TrackedViewInfo::activeWindowTouching() const
 {
     return m_activeWindowTouching;
@@ -144,6 +221,26 @@ void TrackedViewInfo::setTouchingWindowScheme(SchemeColors *scheme)
     m_touchingWindowScheme = scheme;
 }
 
+QRect TrackedViewInfo::absoluteGeometry() const
+{
+    return m_absoluteGeometry;
+}
+
+QRect TrackedViewInfo::screenGeometry() const
+{
+    return m_screenGeometry;
+}
+
+Plasma::Types::Location TrackedViewInfo::location() const
+{
+    return m_location;
+}
+
+Plasma::Types::FormFactor TrackedViewInfo::formFactor() const
+{
+    return m_formFactor;
+}
+
 Latte::View *TrackedViewInfo::view() const
 {
     return m_view;
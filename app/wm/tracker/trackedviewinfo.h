@@ -28,6 +28,9 @@
 #include <QObject>
 #include <QRect>
 
+// Plasma
+#include <Plasma>
+
 namespace Latte {
 class View;
 namespace WindowSystem {
@@ -47,9 +50,36 @@ class TrackedViewInfo : public TrackedGeneralInfo {
     Q_OBJECT
 
 public:
+    //! view hints that the view consumers can request, the rest are not evaluated
+    enum ViewHint
+    {
+        NoViewHint = 0x000,
+        ActiveWindowMaximizedHint = 0x001,
+        ActiveWindowTouchingHint = 0x002,
+        ActiveWindowTouchingEdgeHint = 0x004,
+        ExistsWindowActiveHint = 0x008,
+        ExistsWindowMaximizedHint = 0x010,
+        ExistsWindowTouchingHint = 0x020,
+        ExistsWindowTouchingEdgeHint = 0x040,
+        TouchingBusyVerticalViewHint = 0x080,
+        ActiveWindowSchemeHint = 0x100,
+        TouchingWindowSchemeHint = 0x200,
+        AllViewHints = 0x3FF
+    };
+    Q_DECLARE_FLAGS(ViewHints, ViewHint)
+
     TrackedViewInfo(Tracker::Windows *tracker, Latte::View *view);
+    //! view without a window that provides only its geometry, it is used from benchmarks
+    TrackedViewInfo(Tracker::Windows *tracker, const QRect &absoluteGeometry, const QRect &screenGeometry, const Plasma::Types::Location &location);
     ~TrackedViewInfo() override;
 
+    ViewHints requestedHints() const;
+    void setRequestedHints(const ViewHints &hints);
+    bool isRequested(const ViewHint &hint) const;
+
+    //! window hints that must be evaluated in order to provide the requested view hints
+    WindowHints requiredWindowHints() const;
+
     bool activeWindowTouching() const;
     void setActiveWindowTouching(bool touching);
 
@@ -71,6 +101,12 @@ public:
     SchemeColors *touchingWindowScheme() const;
     void setTouchingWindowScheme(SchemeColors *scheme);
 
+    //! view geometry is cached because it is needed for every evaluated window
+    QRect absoluteGeometry() const;
+    QRect screenGeometry() const;
+    Plasma::Types::Location location() const;
+    Plasma::Types::FormFactor formFactor() const;
+
     Latte::View *view() const;
 
     bool isTracking(const WindowInfoWrap &winfo) const override;
@@ -82,13 +118,23 @@ private:
     bool m_existsWindowTouchingEdge{false};
     bool m_isTouchingBusyVerticalView{false};
 
+    //! until the view consumers are known all hints are evaluated
+    ViewHints m_requestedHints{AllViewHints};
+
     QRect m_availableScreenGeometry;
+    QRect m_absoluteGeometry;
+    QRect m_screenGeometry;
+
+    Plasma::Types::Location m_location{Plasma::Types::Floating};
+    Plasma::Types::FormFactor m_formFactor{Plasma::Types::Planar};
 
     SchemeColors *m_touchingWindowScheme{nullptr};
 
     Latte::View *m_view{nullptr};
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(TrackedViewInfo::ViewHints)
+
 }
 }
 }
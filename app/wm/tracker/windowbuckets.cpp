@@ -0,0 +1,199 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "windowbuckets.h"
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+WindowBuckets::WindowBuckets()
+{
+}
+
+void WindowBuckets::insert(const WindowInfoWrap &winfo)
+{
+    WindowKey key = winfo.key();
+
+    Placement placement;
+    placement.onAllDesktops = winfo.isOnAllDesktops();
+    placement.onAllActivities = winfo.isOnAllActivities();
+
+    if (!placement.onAllDesktops) {
+        placement.desktops = winfo.desktops();
+    }
+
+    if (!placement.onAllActivities) {
+        placement.activities = winfo.activities();
+    }
+
+    if (m_placements.contains(key) && m_placements[key] == placement) {
+        //! most window changes, e.g. geometry and state, do not move windows between buckets
+        return;
+    }
+
+    remove(key.toWindowId());
+
+    if (placement.onAllDesktops) {
+        m_allDesktopsBucket.insert(key);
+    } else {
+        for (const auto &desktop : placement.desktops) {
+            m_desktopBuckets[desktop].insert(key);
+        }
+    }
+
+    if (placement.onAllActivities) {
+        m_allActivitiesBucket.insert(key);
+    } else {
+        for (const auto &activity : placement.activities) {
+            m_activityBuckets[activity].insert(key);
+        }
+    }
+
+    m_placements[key] = placement;
+
+    if (inCurrentDesktop(key) && inCurrentActivity(key)) {
+        m_visibleWindows.insert(key);
+    }
+}
+
+void WindowBuckets::remove(const WindowId &wid)
+{
+    WindowKey key(wid);
+
+    if (!m_placements.contains(key)) {
+        return;
+    }
+
+    Placement placement = m_placements.take(key);
+
+    if (placement.onAllDesktops) {
+        m_allDesktopsBucket.remove(key);
+    } else {
+        for (const auto &desktop : placement.desktops) {
+            m_desktopBuckets[desktop].remove(key);
+
+            if (m_desktopBuckets[desktop].isEmpty()) {
+                m_desktopBuckets.remove(desktop);
+            }
+        }
+    }
+
+    if (placement.onAllActivities) {
+        m_allActivitiesBucket.remove(key);
+    } else {
+        for (const auto &activity : placement.activities) {
+            m_activityBuckets[activity].remove(key);
+
+            if (m_activityBuckets[activity].isEmpty()) {
+                m_activityBuckets.remove(activity);
+            }
+        }
+    }
+
+    m_visibleWindows.remove(key);
+}
+
+void WindowBuckets::clear()
+{
+    m_desktopBuckets.clear();
+    m_allDesktopsBucket.clear();
+    m_activityBuckets.clear();
+    m_allActivitiesBucket.clear();
+    m_placements.clear();
+    m_visibleWindows.clear();
+}
+
+QString WindowBuckets::currentDesktop() const
+{
+    return m_currentDesktop;
+}
+
+QString WindowBuckets::currentActivity() const
+{
+    return m_currentActivity;
+}
+
+void WindowBuckets::setCurrent(const QString &desktop, const QString &activity)
+{
+    if (m_currentDesktop == desktop && m_currentActivity == activity) {
+        return;
+    }
+
+    m_currentDesktop = desktop;
+    m_currentActivity = activity;
+
+    updateVisibleWindows();
+}
+
+bool WindowBuckets::isVisible(const WindowId &wid) const
+{
+    return m_visibleWindows.contains(WindowKey(wid));
+}
+
+const QSet<WindowKey> &WindowBuckets::visibleWindows() const
+{
+    return m_visibleWindows;
+}
+
+bool WindowBuckets::inCurrentDesktop(const WindowKey &key) const
+{
+    if (m_allDesktopsBucket.contains(key)) {
+        return true;
+    }
+
+    auto bucket = m_desktopBuckets.constFind(m_currentDesktop);
+    return bucket != m_desktopBuckets.constEnd() && bucket.value().contains(key);
+}
+
+bool WindowBuckets::inCurrentActivity(const WindowKey &key) const
+{
+    if (m_allActivitiesBucket.contains(key)) {
+        return true;
+    }
+
+    auto bucket = m_activityBuckets.constFind(m_currentActivity);
+    return bucket != m_activityBuckets.constEnd() && bucket.value().contains(key);
+}
+
+void WindowBuckets::updateVisibleWindows()
+{
+    m_visibleWindows.clear();
+
+    //! only the windows of the current desktop buckets are checked for their activity
+    for (const auto &key : m_allDesktopsBucket) {
+        if (inCurrentActivity(key)) {
+            m_visibleWindows.insert(key);
+        }
+    }
+
+    auto desktopBucket = m_desktopBuckets.constFind(m_currentDesktop);
+
+    if (desktopBucket != m_desktopBuckets.constEnd()) {
+        for (const auto &key : desktopBucket.value()) {
+            if (inCurrentActivity(key)) {
+                m_visibleWindows.insert(key);
+            }
+        }
+    }
+}
+
+}
+}
+}
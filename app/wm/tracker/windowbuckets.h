@@ -0,0 +1,97 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMTRACKERWINDOWBUCKETS_H
+#define WINDOWSYSTEMTRACKERWINDOWBUCKETS_H
+
+// local
+#include "../windowinfowrap.h"
+
+// Qt
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! Windows partitioned by virtual desktop and activity. Windows that are shown on all
+//! desktops or activities are kept in shared buckets. The windows that are visible in the
+//! current desktop and activity are evaluated once when the current desktop or activity
+//! changes and afterwards only for the windows whose placement is changing
+class WindowBuckets
+{
+public:
+    WindowBuckets();
+
+    void insert(const WindowInfoWrap &winfo);
+    void remove(const WindowId &wid);
+    void clear();
+
+    QString currentDesktop() const;
+    QString currentActivity() const;
+    void setCurrent(const QString &desktop, const QString &activity);
+
+    //! windows that are placed in the current desktop and activity
+    bool isVisible(const WindowId &wid) const;
+    const QSet<WindowKey> &visibleWindows() const;
+
+private:
+    struct Placement
+    {
+        bool onAllDesktops{false};
+        bool onAllActivities{false};
+        QStringList desktops;
+        QStringList activities;
+
+        bool operator==(const Placement &rhs) const {
+            return onAllDesktops == rhs.onAllDesktops
+                    && onAllActivities == rhs.onAllActivities
+                    && desktops == rhs.desktops
+                    && activities == rhs.activities;
+        }
+    };
+
+    bool inCurrentActivity(const WindowKey &key) const;
+    bool inCurrentDesktop(const WindowKey &key) const;
+
+    void updateVisibleWindows();
+
+private:
+    QString m_currentDesktop;
+    QString m_currentActivity;
+
+    QHash<QString, QSet<WindowKey>> m_desktopBuckets;
+    QSet<WindowKey> m_allDesktopsBucket;
+
+    QHash<QString, QSet<WindowKey>> m_activityBuckets;
+    QSet<WindowKey> m_allActivitiesBucket;
+
+    QHash<WindowKey, Placement> m_placements;
+
+    QSet<WindowKey> m_visibleWindows;
+};
+
+}
+}
+}
+
+#endif
@@ -25,6 +25,7 @@
 #include "trackedlayoutinfo.h"
 #include "trackedviewinfo.h"
 #include "../abstractwindowinterface.h"
+#include "../appidentitycache.h"
 #include "../schemecolors.h"
 #include "../../apptypes.h"
 #include "../../lattecorona.h"
@@ -33,10 +34,21 @@
 #include "../../view/view.h"
 #include "../../view/positioner.h"
 
+// Qt
+#include <QDebug>
+
+// Plasma
+#include <Plasma/Containment>
+
 namespace Latte {
 namespace WindowSystem {
 namespace Tracker {
 
+//! about one display frame
+const int EVENTSBATCHINTERVAL = 16;
+//! window information requests that take longer are considered lost
+const int FETCHINFOSTIMEOUT = 1000;
+
 Windows::Windows(AbstractWindowInterface *parent)
     : QObject(parent)
 {
@@ -52,6 +64,30 @@ Windows::Windows(AbstractWindowInterface *parent)
     m_updateApplicationDataTimer.setSingleShot(true);
     connect(&m_updateApplicationDataTimer, &QTimer::timeout, this, &Windows::updateApplicationData);
 
+    //! application urls are resolved asynchronously, windows that were waiting for them are updated again
+    connect(AppIdentityCache::self(), &AppIdentityCache::windowUrlResolved, this, [&]() {
+        for (const auto &wid : m_unresolvedApplicationData) {
+            if (!m_delayedApplicationData.contains(wid)) {
+                m_delayedApplicationData.append(wid);
+            }
+        }
+
+        m_unresolvedApplicationData.clear();
+
+        if (!m_delayedApplicationData.isEmpty()) {
+            m_updateApplicationDataTimer.start();
+        }
+    });
+
+    //! window system events batching
+    m_eventsBatchTimer.setInterval(EVENTSBATCHINTERVAL);
+    m_eventsBatchTimer.setSingleShot(true);
+    connect(&m_eventsBatchTimer, &QTimer::timeout, this, &Windows::processEventsBatch);
+
+    m_fetchInfosTimer.setInterval(FETCHINFOSTIMEOUT);
+    m_fetchInfosTimer.setSingleShot(true);
+    connect(&m_fetchInfosTimer, &QTimer::timeout, this, &Windows::fetchInfosTimedOut);
+
     init();
 }
 
@@ -76,63 +112,322 @@ Windows::~Windows()
 
 void Windows::init()
 {
-    connect(m_wm->corona(), &Plasma::Corona::availableScreenRectChanged, this, &Windows::updateAvailableScreenGeometries);
+    if (m_wm->corona()) {
+        connect(m_wm->corona(), &Plasma::Corona::availableScreenRectChanged, this, &Windows::updateAvailableScreenGeometries);
+    }
 
-    connect(m_wm, &AbstractWindowInterface::windowChanged, this, [&](WindowId wid) {
-        m_windows[wid] = m_wm->requestInfo(wid);
-        updateAllHints();
+    connect(m_wm, &AbstractWindowInterface::windowInfosReceived, this, &Windows::finishEventsBatch);
 
-        emit windowChanged(wid);
+    connect(m_wm, &AbstractWindowInterface::windowChanged, this, [&](WindowId wid, const WindowProperties &properties) {
+        m_statistics.addEvent(Statistics::WindowChangedEvent);
+
+        m_eventsBatch.removedWindows.removeAll(wid);
+
+        if (!m_eventsBatch.changedWindows.contains(wid)) {
+            m_eventsBatch.changedWindows << wid;
+        }
+
+        m_eventsBatch.changedProperties[wid] |= properties;
+
+        scheduleEventsBatch();
     });
 
     connect(m_wm, &AbstractWindowInterface::windowRemoved, this, [&](WindowId wid) {
-        m_windows.remove(wid);
+        m_statistics.addEvent(Statistics::WindowRemovedEvent);
 
-        //! application data
-        m_initializedApplicationData.removeAll(wid);
-        m_delayedApplicationData.removeAll(wid);
+        m_eventsBatch.addedWindows.removeAll(wid);
+        m_eventsBatch.changedWindows.removeAll(wid);
+        m_eventsBatch.changedProperties.remove(wid);
 
-        updateAllHints();
+        if (!m_eventsBatch.removedWindows.contains(wid)) {
+            m_eventsBatch.removedWindows << wid;
+        }
 
-        emit windowRemoved(wid);
+        scheduleEventsBatch();
     });
 
     connect(m_wm, &AbstractWindowInterface::windowAdded, this, [&](WindowId wid) {
-        if (!m_windows.contains(wid)) {
-            m_windows.insert(wid, m_wm->requestInfo(wid));
+        m_statistics.addEvent(Statistics::WindowAddedEvent);
+
+        if (m_eventsBatch.removedWindows.removeAll(wid) > 0 && !m_eventsBatch.changedWindows.contains(wid)) {
+            //! window was recreated within the same batch, its information must be refreshed
+            m_eventsBatch.changedWindows << wid;
+            m_eventsBatch.changedProperties[wid] = AllWindowProperties;
         }
-        updateAllHints();
+
+        if (!m_eventsBatch.addedWindows.contains(wid)) {
+            m_eventsBatch.addedWindows << wid;
+        }
+
+        scheduleEventsBatch();
     });
 
     connect(m_wm, &AbstractWindowInterface::activeWindowChanged, this, [&](WindowId wid) {
+        m_statistics.addEvent(Statistics::ActiveWindowChangedEvent);
+
+        m_eventsBatch.activeWindowChanged = true;
+        m_eventsBatch.activeWindow = wid;
+
+        scheduleEventsBatch();
+    });
+
+    connect(m_wm, &AbstractWindowInterface::currentDesktopChanged, this, [&] {
+        m_statistics.addEvent(Statistics::CurrentDesktopChangedEvent);
+
+        updateCurrentDesktopActivity();
+
+        m_eventsBatch.fullUpdate = true;
+
+        scheduleEventsBatch();
+    });
+
+    connect(m_wm, &AbstractWindowInterface::currentActivityChanged, this, [&] {
+        m_statistics.addEvent(Statistics::CurrentActivityChangedEvent);
+
+        updateCurrentDesktopActivity();
+
+        m_eventsBatch.activityChanged = true;
+        m_eventsBatch.fullUpdate = true;
+
+        scheduleEventsBatch();
+    });
+}
+
+void Windows::scheduleEventsBatch()
+{
+    if (m_eventsBatch.hasEvents) {
+        //! the event is evaluated together with the rest events of the pending batch
+        m_statistics.addCoalescedEvent();
+    }
+
+    m_eventsBatch.hasEvents = true;
+
+    if (!m_eventsBatchTimer.isActive() && !m_isFetchingInfos) {
+        m_eventsBatchTimer.start();
+    }
+}
+
+void Windows::processEventsBatch()
+{
+    if (m_isFetchingInfos || !m_eventsBatch.hasEvents) {
+        //! the batch is processed after the pending window information requests are received
+        return;
+    }
+
+    //! batch state is reset before processing because signals emitted from here
+    //! may trigger new window system events
+    m_fetchingBatch = m_eventsBatch;
+    m_eventsBatch = EventsBatch();
+
+    m_eventsBatchElapsed.start();
+    emit eventsBatchStarted();
+
+    for (const auto &wid : m_fetchingBatch.removedWindows) {
+        removeWindowInfo(wid);
+
+        //! application data
+        m_initializedApplicationData.removeAll(wid);
+        m_delayedApplicationData.removeAll(wid);
+        m_unresolvedApplicationData.removeAll(wid);
+        AppIdentityCache::self()->removeWindow(wid);
+    }
+
+    QList<WindowId> &requestedWindows = m_fetchingBatch.requestedWindows;
+    QList<WindowProperties> &requestedProperties = m_fetchingBatch.requestedProperties;
+
+    //! untracked windows are always requested completely, for tracked windows
+    //! only the changed properties are requested again
+    auto requestWindow = [&](const WindowId &wid, const WindowProperties &properties) {
+        WindowProperties windowProperties = m_windows.contains(wid) ? properties : AllWindowProperties;
+        int index = requestedWindows.indexOf(wid);
+
+        if (index >= 0) {
+            requestedProperties[index] |= windowProperties;
+        } else {
+            requestedWindows << wid;
+            requestedProperties << windowProperties;
+        }
+    };
+
+    for (const auto &wid : m_fetchingBatch.addedWindows) {
+        if (!m_windows.contains(wid)) {
+            requestWindow(wid, AllWindowProperties);
+        }
+    }
+
+    for (const auto &wid : m_fetchingBatch.changedWindows) {
+        requestWindow(wid, m_fetchingBatch.changedProperties.value(wid, AllWindowProperties));
+    }
+
+    if (m_fetchingBatch.activeWindowChanged) {
         //! for some reason this is needed in order to update properly activeness values
         //! when the active window changes the previous active windows should be also updated
         for (const auto view : m_views.keys()) {
             WindowId lastWinId = m_views[view]->lastActiveWindow()->winId();
-            if ((lastWinId) != wid && m_windows.contains(lastWinId)) {
-                m_windows[lastWinId] = m_wm->requestInfo(lastWinId);
+            if ((lastWinId) != m_fetchingBatch.activeWindow && m_windows.contains(lastWinId)) {
+                requestWindow(lastWinId, ActiveWindowProperty);
             }
         }
 
-        m_windows[wid] = m_wm->requestInfo(wid);
-        updateAllHints();
+        requestWindow(m_fetchingBatch.activeWindow, ActiveWindowProperty);
+    }
 
-        emit activeWindowChanged(wid);
-    });
+    //! window information for the entire batch is requested at once and
+    //! the batch is completed when it is received
+    m_isFetchingInfos = true;
+    m_fetchInfosTimer.start();
+    m_wm->requestInfosAsync(requestedWindows, requestedProperties);
+}
 
-    connect(m_wm, &AbstractWindowInterface::currentDesktopChanged, this, [&] {
-        updateAllHints();
-    });
+void Windows::finishEventsBatch(const QList<WindowId> &wids, const QList<WindowInfoWrap> &infos)
+{
+    if (!m_isFetchingInfos) {
+        return;
+    }
 
-    connect(m_wm, &AbstractWindowInterface::currentActivityChanged, this, [&] {
-        if (m_wm->corona()->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts) {
-            //! this is needed in MultipleLayouts because there is a chance that multiple
-            //! layouts are providing different available screen geometries in different Activities
-            updateAvailableScreenGeometries();
+    m_isFetchingInfos = false;
+    m_fetchInfosTimer.stop();
+
+    EventsBatch batch = m_fetchingBatch;
+    m_fetchingBatch = EventsBatch();
+
+    //! window titles are not used for any hint
+    QList<WindowId> hintsWindows = batch.removedWindows;
+
+    for (int i=0; i<wids.count() && i<infos.count(); ++i) {
+        WindowProperties properties = batch.requestedProperties.value(i, AllWindowProperties);
+
+        if (properties == AllWindowProperties || !m_windows.contains(wids[i])) {
+            setWindowInfo(wids[i], infos[i]);
+        } else {
+            //! unchanged properties of the cached window information are kept
+            WindowInfoWrap winfo = m_windows[wids[i]];
+            winfo.updateProperties(infos[i], properties);
+            setWindowInfo(wids[i], winfo);
+        }
+
+        if (properties & ~NameWindowProperty) {
+            hintsWindows << wids[i];
         }
+    }
 
+    if (batch.activityChanged && m_wm->corona() && m_wm->corona()->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts) {
+        //! this is needed in MultipleLayouts because there is a chance that multiple
+        //! layouts are providing different available screen geometries in different Activities
+        updateAvailableScreenGeometries();
+    }
+
+    //! hints are evaluated only once for the entire batch
+    QElapsedTimer hintsPassTimer;
+    hintsPassTimer.start();
+
+    if (batch.fullUpdate) {
         updateAllHints();
-    });
+    } else {
+        updateWindowHints(hintsWindows);
+    }
+
+    m_statistics.addHintsPassDuration(hintsPassTimer.nsecsElapsed());
+
+    for (const auto &wid : batch.removedWindows) {
+        emit windowRemoved(wid);
+    }
+
+    for (const auto &wid : batch.changedWindows) {
+        emit windowChanged(wid);
+    }
+
+    if (batch.activeWindowChanged) {
+        emit activeWindowChanged(batch.activeWindow);
+    }
+
+    m_lastEventsBatchDuration = m_eventsBatchElapsed.nsecsElapsed();
+    m_statistics.addBatchDuration(m_lastEventsBatchDuration);
+    emit eventsBatchFinished();
+
+    //! events that arrived while window information was requested
+    if (m_eventsBatch.hasEvents && !m_eventsBatchTimer.isActive()) {
+        m_eventsBatchTimer.start();
+    }
+}
+
+void Windows::fetchInfosTimedOut()
+{
+    if (!m_isFetchingInfos) {
+        return;
+    }
+
+    qWarning() << "Window information for" << m_fetchingBatch.requestedWindows.count()
+               << "windows was not received in time, it is requested synchronously";
+
+    //! results of the timed out request must not be assigned to later batches
+    m_wm->cancelInfosAsync();
+
+    QList<WindowId> wids = m_fetchingBatch.requestedWindows;
+    finishEventsBatch(wids, m_wm->requestInfos(wids, m_fetchingBatch.requestedProperties));
+}
+
+quint64 Windows::eventsReceived() const
+{
+    return m_statistics.receivedEvents();
+}
+
+quint64 Windows::eventsMerged() const
+{
+    return m_statistics.coalescedEvents();
+}
+
+quint64 Windows::hintsEvaluated() const
+{
+    return m_statistics.hintsEvaluations();
+}
+
+QStringList Windows::statistics() const
+{
+    QStringList entries = m_statistics.toStringList();
+    entries << QStringLiteral("windows.tracked=%1").arg(m_windows.count());
+    entries << QStringLiteral("views.tracked=%1").arg(m_views.count());
+    entries << QStringLiteral("layouts.tracked=%1").arg(m_layouts.count());
+
+    return entries;
+}
+
+void Windows::resetStatistics()
+{
+    m_statistics.reset();
+}
+
+void Windows::addLastActiveWindowUpdate(int changedFields, int suppressedFields)
+{
+    m_statistics.addLastActiveWindowUpdate(changedFields, suppressedFields);
+}
+
+qint64 Windows::lastEventsBatchDuration() const
+{
+    return m_lastEventsBatchDuration;
+}
+
+void Windows::flushEventsBatch()
+{
+    m_eventsBatchTimer.stop();
+    processEventsBatch();
+}
+
+void Windows::addSyntheticView(const QRect &absoluteGeometry, const QRect &screenGeometry, const Plasma::Types::Location &location)
+{
+    m_syntheticViews << new TrackedViewInfo(this, absoluteGeometry, screenGeometry, location);
+    updateAllHints();
+}
+
+void Windows::removeSyntheticViews()
+{
+    qDeleteAll(m_syntheticViews);
+    m_syntheticViews.clear();
+}
+
+bool Windows::hasPendingEvents() const
+{
+    return m_isFetchingInfos || m_eventsBatch.hasEvents;
 }
 
 void Windows::initLayoutHints(Latte::Layout::GenericLayout *layout)
@@ -141,6 +436,8 @@ void Windows::initLayoutHints(Latte::Layout::GenericLayout *layout)
         return;
     }
 
+    m_layouts[layout]->clearContributions();
+
     setActiveWindowMaximized(layout, false);
     setExistsWindowActive(layout, false);
     setExistsWindowMaximized(layout, false);
@@ -153,6 +450,8 @@ void Windows::initViewHints(Latte::View *view)
         return;
     }
 
+    m_views[view]->clearContributions();
+
     setActiveWindowMaximized(view, false);
     setActiveWindowTouching(view, false);
     setActiveWindowTouchingEdge(view, false);
@@ -188,10 +487,42 @@ void Windows::addView(Latte::View *view)
         addRelevantLayout(view);
     });
 
-    connect(view, &Latte::View::isTouchingBottomViewAndIsBusyChanged, this, &Windows::updateExtraViewHints);
-    connect(view, &Latte::View::isTouchingTopViewAndIsBusyChanged, this, &Windows::updateExtraViewHints);
+    //! views registry in order to find directly the views of the same screen edges
+    updateScreenEdgeRegistry(view);
+
+    connect(view, &Latte::View::locationChanged, this, [&, view]() {
+        updateScreenEdgeRegistry(view);
+    });
+
+    connect(view->positioner(), &Latte::ViewPart::Positioner::currentScreenChanged, this, [&, view]() {
+        updateScreenEdgeRegistry(view);
+    });
+
+    connect(view, &Latte::View::isTouchingBottomViewAndIsBusyChanged, this, [&, view]() {
+        scheduleExtraViewHints(view);
+    });
+
+    connect(view, &Latte::View::isTouchingTopViewAndIsBusyChanged, this, [&, view]() {
+        scheduleExtraViewHints(view);
+    });
+
+    //! windows contributions are relevant to view geometry, so they must be re-evaluated
+    connect(view, &Latte::View::absoluteGeometryChanged, this, [&, view]() {
+        updateHints(view);
+        scheduleExtraViewHints(view);
+    });
+
+    connect(view, &Latte::View::screenGeometryChanged, this, [&, view]() {
+        updateHints(view);
+    });
+
+    connect(m_views[view], &TrackedGeneralInfo::isTrackingCurrentActivityChanged, this, [&, view]() {
+        updateHints(view);
+        scheduleExtraViewHints(view);
+    });
 
     updateAllHints();
+    scheduleExtraViewHints(view);
 
     emit informationAnnounced(view);
 }
@@ -205,9 +536,84 @@ void Windows::removeView(Latte::View *view)
     m_views[view]->deleteLater();
     m_views.remove(view);
 
+    //! horizontal views that were touching it must be re-evaluated
+    if (m_viewScreenEdges.contains(view)) {
+        ScreenEdge screenEdge = m_viewScreenEdges.take(view);
+        m_screenEdgeViews[screenEdge].removeAll(view);
+
+        if (m_screenEdgeViews[screenEdge].isEmpty()) {
+            m_screenEdgeViews.remove(screenEdge);
+        }
+
+        scheduleExtraViewHints(screenEdge.first);
+    }
+
+    m_extraViewHintsPending.remove(view);
+
     updateRelevantLayouts();
 }
 
+void Windows::updateScreenEdgeRegistry(Latte::View *view)
+{
+    if (!m_views.contains(view)) {
+        return;
+    }
+
+    ScreenEdge screenEdge(view->positioner()->currentScreenId(), view->location());
+
+    if (m_viewScreenEdges.contains(view)) {
+        ScreenEdge previous = m_viewScreenEdges[view];
+
+        if (previous == screenEdge) {
+            return;
+        }
+
+        m_screenEdgeViews[previous].removeAll(view);
+
+        if (m_screenEdgeViews[previous].isEmpty()) {
+            m_screenEdgeViews.remove(previous);
+        }
+
+        scheduleExtraViewHints(previous.first);
+    }
+
+    m_viewScreenEdges[view] = screenEdge;
+    m_screenEdgeViews[screenEdge] << view;
+
+    scheduleExtraViewHints(view);
+}
+
+void Windows::scheduleExtraViewHints(const int &screen)
+{
+    m_extraViewHintsPending += m_screenEdgeViews.value(ScreenEdge(screen, Plasma::Types::TopEdge)).toSet();
+    m_extraViewHintsPending += m_screenEdgeViews.value(ScreenEdge(screen, Plasma::Types::BottomEdge)).toSet();
+
+    if (!m_extraViewHintsTimer.isActive()) {
+        m_extraViewHintsTimer.start();
+    }
+}
+
+void Windows::scheduleExtraViewHints(Latte::View *view)
+{
+    if (!m_viewScreenEdges.contains(view)) {
+        return;
+    }
+
+    ScreenEdge screenEdge = m_viewScreenEdges[view];
+
+    if (screenEdge.second == Plasma::Types::LeftEdge || screenEdge.second == Plasma::Types::RightEdge) {
+        //! a vertical view affects only the top and bottom views of its screen
+        scheduleExtraViewHints(screenEdge.first);
+        return;
+    }
+
+    m_extraViewHintsPending << view;
+
+    if (!m_extraViewHintsTimer.isActive()) {
+        m_extraViewHintsTimer.start();
+    }
+}
+
 void Windows::addRelevantLayout(Latte::View *view)
 {
     if (view->layout()) {
@@ -215,7 +621,12 @@ void Windows::addRelevantLayout(Latte::View *view)
 
         if (!m_layouts.contains(view->layout())) {
             initializing = true;
-            m_layouts[view->layout()] = new TrackedLayoutInfo(this, view->layout());
+            Latte::Layout::GenericLayout *layout = view->layout();
+            m_layouts[layout] = new TrackedLayoutInfo(this, layout);
+
+            connect(m_layouts[layout], &TrackedGeneralInfo::isTrackingCurrentActivityChanged, this, [&, layout]() {
+                updateHints(layout);
+            });
         }
 
         //! Update always the AllScreens tracking because there is a chance a view delayed to be assigned in a layout
@@ -267,10 +678,13 @@ void Windows::updateRelevantLayouts()
         }
 
         if (i.value()) {
+            bool wasEnabled = i.value()->enabled();
             i.value()->setEnabled(hasViewEnabled);
 
             if (!hasViewEnabled) {
                 initLayoutHints(i.key());
+            } else if (!wasEnabled) {
+                updateHints(i.key());
             }
         }
     }
@@ -302,64 +716,138 @@ void Windows::setEnabled(Latte::View *view, const bool enabled)
     }
 
     updateRelevantLayouts();
+    scheduleExtraViewHints(view);
 
     emit enabledChanged(view);
 }
 
-bool Windows::activeWindowMaximized(Latte::View *view) const
+TrackedViewInfo::ViewHints Windows::requestedHints(Latte::View *view) const
 {
     if (!m_views.contains(view)) {
-        return false;
+        return TrackedViewInfo::NoViewHint;
     }
 
-    return m_views[view]->activeWindowMaximized();
+    return m_views[view]->requestedHints();
 }
 
-void Windows::setActiveWindowMaximized(Latte::View *view, bool activeMaximized)
+void Windows::setRequestedHints(Latte::View *view, const TrackedViewInfo::ViewHints &hints)
 {
-    if (!m_views.contains(view) || m_views[view]->activeWindowMaximized() == activeMaximized) {
+    if (!m_views.contains(view) || m_views[view]->requestedHints() == hints) {
         return;
     }
 
-    m_views[view]->setActiveWindowMaximized(activeMaximized);
-    emit activeWindowMaximizedChanged(view);
-}
+    bool busyVerticalViewAdded = !m_views[view]->isRequested(TrackedViewInfo::TouchingBusyVerticalViewHint)
+            && hints.testFlag(TrackedViewInfo::TouchingBusyVerticalViewHint);
 
-bool Windows::activeWindowTouching(Latte::View *view) const
-{
-    if (!m_views.contains(view)) {
-        return false;
+    m_views[view]->setRequestedHints(hints);
+
+    //! hints that are not requested any more are reset, so they can not be read with stale values
+    if (!hints.testFlag(TrackedViewInfo::ActiveWindowMaximizedHint)) {
+        setActiveWindowMaximized(view, false);
     }
 
-    return m_views[view]->activeWindowTouching();
-}
+    if (!hints.testFlag(TrackedViewInfo::ActiveWindowTouchingHint)) {
+        setActiveWindowTouching(view, false);
+    }
 
-void Windows::setActiveWindowTouching(Latte::View *view, bool activeTouching)
-{
-    if (!m_views.contains(view) || m_views[view]->activeWindowTouching() == activeTouching) {
-        return;
+    if (!hints.testFlag(TrackedViewInfo::ActiveWindowTouchingEdgeHint)) {
+        setActiveWindowTouchingEdge(view, false);
     }
 
-    m_views[view]->setActiveWindowTouching(activeTouching);
-    emit activeWindowTouchingChanged(view);
-}
+    if (!hints.testFlag(TrackedViewInfo::ExistsWindowActiveHint)) {
+        setExistsWindowActive(view, false);
+    }
 
-bool Windows::activeWindowTouchingEdge(Latte::View *view) const
-{
-    if (!m_views.contains(view)) {
-        return false;
+    if (!hints.testFlag(TrackedViewInfo::ExistsWindowMaximizedHint)) {
+        setExistsWindowMaximized(view, false);
     }
 
-    return m_views[view]->activeWindowTouchingEdge();
-}
+    if (!hints.testFlag(TrackedViewInfo::ExistsWindowTouchingHint)) {
+        setExistsWindowTouching(view, false);
+    }
 
-void Windows::setActiveWindowTouchingEdge(Latte::View *view, bool activeTouchingEdge)
-{
-    if (!m_views.contains(view) || m_views[view]->activeWindowTouchingEdge() == activeTouchingEdge) {
-        return;
+    if (!hints.testFlag(TrackedViewInfo::ExistsWindowTouchingEdgeHint)) {
+        setExistsWindowTouchingEdge(view, false);
+    }
+
+    if (!hints.testFlag(TrackedViewInfo::TouchingBusyVerticalViewHint)) {
+        setIsTouchingBusyVerticalView(view, false);
+    }
+
+    if (!hints.testFlag(TrackedViewInfo::ActiveWindowSchemeHint)) {
+        setActiveWindowScheme(view, nullptr);
+    }
+
+    if (!hints.testFlag(TrackedViewInfo::TouchingWindowSchemeHint)) {
+        setTouchingWindowScheme(view, nullptr);
+    }
+
+    //! newly requested hints must be evaluated and window contributions must
+    //! follow the new required window hints
+    updateHints(view);
+
+    if (busyVerticalViewAdded) {
+        scheduleExtraViewHints(view);
+    }
+}
+
+bool Windows::activeWindowMaximized(Latte::View *view) const
+{
+    if (!m_views.contains(view)) {
+        return false;
+    }
+
+    return m_views[view]->activeWindowMaximized();
+}
+
+void Windows::setActiveWindowMaximized(Latte::View *view, bool activeMaximized)
+{
+    if (!m_views.contains(view) || m_views[view]->activeWindowMaximized() == activeMaximized) {
+        return;
+    }
+
+    m_views[view]->setActiveWindowMaximized(activeMaximized);
+    m_statistics.addHintFlip();
+    emit activeWindowMaximizedChanged(view);
+}
+
+bool Windows::activeWindowTouching(Latte::View *view) const
+{
+    if (!m_views.contains(view)) {
+        return false;
+    }
+
+    return m_views[view]->activeWindowTouching();
+}
+
+void Windows::setActiveWindowTouching(Latte::View *view, bool activeTouching)
+{
+    if (!m_views.contains(view) || m_views[view]->activeWindowTouching() == activeTouching) {
+        return;
+    }
+
+    m_views[view]->setActiveWindowTouching(activeTouching);
+    m_statistics.addHintFlip();
+    emit activeWindowTouchingChanged(view);
+}
+
+bool Windows::activeWindowTouchingEdge(Latte::View *view) const
+{
+    if (!m_views.contains(view)) {
+        return false;
+    }
+
+    return m_views[view]->activeWindowTouchingEdge();
+}
+
+void Windows::setActiveWindowTouchingEdge(Latte::View *view, bool activeTouchingEdge)
+{
+    if (!m_views.contains(view) || m_views[view]->activeWindowTouchingEdge() == activeTouchingEdge) {
+        return;
     }
 
     m_views[view]->setActiveWindowTouchingEdge(activeTouchingEdge);
+    m_statistics.addHintFlip();
     emit activeWindowTouchingEdgeChanged(view);
 }
 
@@ -379,6 +867,7 @@ void Windows::setExistsWindowActive(Latte::View *view, bool windowActive)
     }
 
     m_views[view]->setExistsWindowActive(windowActive);
+    m_statistics.addHintFlip();
     emit existsWindowActiveChanged(view);
 }
 
@@ -398,6 +887,7 @@ void Windows::setExistsWindowMaximized(Latte::View *view, bool windowMaximized)
     }
 
     m_views[view]->setExistsWindowMaximized(windowMaximized);
+    m_statistics.addHintFlip();
     emit existsWindowMaximizedChanged(view);
 }
 
@@ -417,6 +907,7 @@ void Windows::setExistsWindowTouching(Latte::View *view, bool windowTouching)
     }
 
     m_views[view]->setExistsWindowTouching(windowTouching);
+    m_statistics.addHintFlip();
     emit existsWindowTouchingChanged(view);
 }
 
@@ -436,6 +927,7 @@ void Windows::setExistsWindowTouchingEdge(Latte::View *view, bool windowTouching
     }
 
     m_views[view]->setExistsWindowTouchingEdge(windowTouchingEdge);
+    m_statistics.addHintFlip();
     emit existsWindowTouchingEdgeChanged(view);
 }
 
@@ -456,6 +948,7 @@ void Windows::setIsTouchingBusyVerticalView(Latte::View *view, bool viewTouching
     }
 
     m_views[view]->setIsTouchingBusyVerticalView(viewTouching);
+    m_statistics.addHintFlip();
     emit isTouchingBusyVerticalViewChanged(view);
 }
 
@@ -475,6 +968,7 @@ void Windows::setActiveWindowScheme(Latte::View *view, WindowSystem::SchemeColor
     }
 
     m_views[view]->setActiveWindowScheme(scheme);
+    m_statistics.addHintFlip();
     emit activeWindowSchemeChanged(view);
 }
 
@@ -494,6 +988,7 @@ void Windows::setTouchingWindowScheme(Latte::View *view, WindowSystem::SchemeCol
     }
 
     m_views[view]->setTouchingWindowScheme(scheme);
+    m_statistics.addHintFlip();
     emit touchingWindowSchemeChanged(view);
 }
 
@@ -532,6 +1027,7 @@ void Windows::setActiveWindowMaximized(Latte::Layout::GenericLayout *layout, boo
     }
 
     m_layouts[layout]->setActiveWindowMaximized(activeMaximized);
+    m_statistics.addHintFlip();
     emit activeWindowMaximizedChangedForLayout(layout);
 }
 
@@ -551,6 +1047,7 @@ void Windows::setExistsWindowActive(Latte::Layout::GenericLayout *layout, bool w
     }
 
     m_layouts[layout]->setExistsWindowActive(windowActive);
+    m_statistics.addHintFlip();
     emit existsWindowActiveChangedForLayout(layout);
 }
 
@@ -570,9 +1067,27 @@ void Windows::setExistsWindowMaximized(Latte::Layout::GenericLayout *layout, boo
     }
 
     m_layouts[layout]->setExistsWindowMaximized(windowMaximized);
+    m_statistics.addHintFlip();
     emit existsWindowMaximizedChangedForLayout(layout);
 }
 
+bool Windows::isSchemeInUse(SchemeColors *scheme) const
+{
+    for (const auto info : m_views) {
+        if (info->activeWindowScheme() == scheme || info->touchingWindowScheme() == scheme) {
+            return true;
+        }
+    }
+
+    for (const auto info : m_layouts) {
+        if (info->activeWindowScheme() == scheme) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 SchemeColors *Windows::activeWindowScheme(Latte::Layout::GenericLayout *layout) const
 {
     if (!m_layouts.contains(layout)) {
@@ -589,6 +1104,7 @@ void Windows::setActiveWindowScheme(Latte::Layout::GenericLayout *layout, Window
     }
 
     m_layouts[layout]->setActiveWindowScheme(scheme);
+    m_statistics.addHintFlip();
     emit activeWindowSchemeChangedForLayout(layout);
 }
 
@@ -621,6 +1137,10 @@ QIcon Windows::iconFor(const WindowId &wid)
     if (m_windows[wid].icon().isNull()) {
         AppData data = m_wm->appDataFor(wid);
 
+        if (data.pending && !m_unresolvedApplicationData.contains(wid)) {
+            m_unresolvedApplicationData.append(wid);
+        }
+
         QIcon icon = data.icon;
 
         if (icon.isNull()) {
@@ -674,7 +1194,13 @@ void Windows::updateApplicationData()
                 m_windows[wid].setIcon(icon);
                 m_windows[wid].setAppName(data.name);
 
-                m_initializedApplicationData.append(wid);
+                if (data.pending && !m_unresolvedApplicationData.contains(wid)) {
+                    m_unresolvedApplicationData.append(wid);
+                }
+
+                if (!m_initializedApplicationData.contains(wid)) {
+                    m_initializedApplicationData.append(wid);
+                }
 
                 emit applicationDataChanged(wid);
             }
@@ -693,12 +1219,116 @@ WindowInfoWrap Windows::infoFor(const WindowId &wid) const
     return m_windows[wid];
 }
 
+QList<WindowId> Windows::windows() const
+{
+    QList<WindowId> wids;
+
+    for (const auto &winfo : m_windows) {
+        wids << winfo.wid();
+    }
+
+    return wids;
+}
+
+
+
+void Windows::setWindowInfo(const WindowId &wid, const WindowInfoWrap &winfo)
+{
+    //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
+    //! such garbage windows are not stored at all
+    if (isFaultyWindow(winfo)) {
+        removeWindowInfo(wid);
+        return;
+    }
+
+    WindowInfoWrap &cachedInfo = m_windows[wid];
+    QString appName = cachedInfo.appName();
+    QIcon icon = cachedInfo.icon();
+
+    cachedInfo = winfo;
+
+    //! application data are retrieved only once and they are kept for the window lifetime
+    if (cachedInfo.appName().isEmpty() && !appName.isEmpty()) {
+        cachedInfo.setAppName(appName);
+    }
+
+    if (cachedInfo.icon().isNull() && !icon.isNull()) {
+        cachedInfo.setIcon(icon);
+    }
+
+    updateCurrentDesktopActivity();
+    m_windowBuckets.insert(cachedInfo);
+    updateTransientIndex(wid, cachedInfo.isChildWindow() ? WindowKey(cachedInfo.parentId()) : WindowKey());
+    m_windowsGrid.insert(wid, winfo.geometry());
+
+    bool activeOrMaximized = (winfo.isActive() || winfo.isMaximized());
+
+    if (activeOrMaximized && !m_activeAndMaximizedWindows.contains(wid)) {
+        m_activeAndMaximizedWindows << wid;
+    } else if (!activeOrMaximized) {
+        m_activeAndMaximizedWindows.removeAll(wid);
+    }
+}
+
+void Windows::updateCurrentDesktopActivity()
+{
+    //! window interfaces may initialize their current desktop without informing,
+    //! buckets are swapped only when the current desktop or activity really changed
+    m_windowBuckets.setCurrent(m_wm->currentDesktop(), m_wm->currentActivity());
+}
 
+void Windows::updateTransientIndex(const WindowId &wid, const WindowKey &parent)
+{
+    WindowKey key(wid);
+    WindowKey previousParent = m_parentWindows.value(key);
+
+    if (previousParent == parent) {
+        return;
+    }
+
+    if (!previousParent.isNull()) {
+        QList<WindowId> &siblings = m_childWindows[previousParent];
+        siblings.removeAll(wid);
+
+        if (siblings.isEmpty()) {
+            m_childWindows.remove(previousParent);
+        }
+
+        m_parentWindows.remove(key);
+    }
+
+    if (!parent.isNull()) {
+        m_childWindows[parent] << wid;
+        m_parentWindows[key] = parent;
+    }
+}
+
+void Windows::removeWindowInfo(const WindowId &wid)
+{
+    m_windows.remove(wid);
+    m_windowBuckets.remove(wid);
+    updateTransientIndex(wid, WindowKey());
+    m_windowsGrid.remove(wid);
+    m_activeAndMaximizedWindows.removeAll(wid);
+}
 
 //! Windows Criteria Functions
-bool Windows::intersects(Latte::View *view, const WindowInfoWrap &winfo)
+bool Windows::isFaultyWindow(const WindowInfoWrap &winfo) const
+{
+    return (winfo.key().isNull() || winfo.geometry() == QRect(0, 0, 0, 0));
+}
+
+bool Windows::isTrackableWindow(const WindowInfoWrap &winfo)
 {
-    return (!winfo.isMinimized() && !winfo.isShaded() && winfo.geometry().intersects(view->absoluteGeometry()));
+    return (winfo.isValid()
+            && m_windowBuckets.isVisible(winfo.wid())
+            && !m_wm->hasBlockedTracking(winfo.wid())
+            && !winfo.isMinimized());
+}
+
+bool Windows::intersects(TrackedViewInfo *viewInfo, const WindowInfoWrap &winfo)
+{
+    return (!winfo.isMinimized() && !winfo.isShaded() && winfo.geometry().intersects(viewInfo->absoluteGeometry()));
 }
 
 bool Windows::isActive(const WindowInfoWrap &winfo)
@@ -706,100 +1336,91 @@ bool Windows::isActive(const WindowInfoWrap &winfo)
     return (winfo.isValid() && winfo.isActive() && !winfo.isMinimized());
 }
 
-bool Windows::isActiveInViewScreen(Latte::View *view, const WindowInfoWrap &winfo)
+bool Windows::isActiveInViewScreen(TrackedViewInfo *viewInfo, const WindowInfoWrap &winfo)
 {
     return (winfo.isValid() && winfo.isActive() &&  !winfo.isMinimized()
-            && m_views[view]->availableScreenGeometry().contains(winfo.geometry().center()));
+            && viewInfo->availableScreenGeometry().contains(winfo.geometry().center()));
 }
 
-bool Windows::isMaximizedInViewScreen(Latte::View *view, const WindowInfoWrap &winfo)
+bool Windows::isMaximizedInViewScreen(TrackedViewInfo *viewInfo, const WindowInfoWrap &winfo)
 {
     //! updated implementation to identify the screen that the maximized window is present
     //! in order to avoid: https://bugs.kde.org/show_bug.cgi?id=397700
     return (winfo.isValid() && !winfo.isMinimized()
             && !winfo.isShaded()
             && winfo.isMaximized()
-            && m_views[view]->availableScreenGeometry().contains(winfo.geometry().center()));
+            && viewInfo->availableScreenGeometry().contains(winfo.geometry().center()));
 }
 
-bool Windows::isTouchingView(Latte::View *view, const WindowSystem::WindowInfoWrap &winfo)
+bool Windows::isTouchingView(TrackedViewInfo *viewInfo, const WindowSystem::WindowInfoWrap &winfo)
 {
-    return (winfo.isValid() && intersects(view, winfo));
+    return (winfo.isValid() && intersects(viewInfo, winfo));
 }
 
-bool Windows::isTouchingViewEdge(Latte::View *view, const QRect &windowgeometry)
+bool Windows::isTouchingViewEdge(TrackedViewInfo *viewInfo, const QRect &windowgeometry)
 {
-    if (!view) {
+    if (!viewInfo) {
         return false;
     }
 
     bool inViewThicknessEdge{false};
     bool inViewLengthBoundaries{false};
 
-    QRect screenGeometry = view->screenGeometry();
+    QRect screenGeometry = viewInfo->screenGeometry();
 
     bool inCurrentScreen{screenGeometry.contains(windowgeometry.topLeft()) || screenGeometry.contains(windowgeometry.bottomRight())};
 
     if (inCurrentScreen) {
-        if (view->location() == Plasma::Types::TopEdge) {
-            inViewThicknessEdge = (windowgeometry.y() == view->absoluteGeometry().bottom() + 1);
-        } else if (view->location() == Plasma::Types::BottomEdge) {
-            inViewThicknessEdge = (windowgeometry.bottom() == view->absoluteGeometry().top() - 1);
-        } else if (view->location() == Plasma::Types::LeftEdge) {
-            inViewThicknessEdge = (windowgeometry.x() == view->absoluteGeometry().right() + 1);
-        } else if (view->location() == Plasma::Types::RightEdge) {
-            inViewThicknessEdge = (windowgeometry.right() == view->absoluteGeometry().left() - 1);
+        if (viewInfo->location() == Plasma::Types::TopEdge) {
+            inViewThicknessEdge = (windowgeometry.y() == viewInfo->absoluteGeometry().bottom() + 1);
+        } else if (viewInfo->location() == Plasma::Types::BottomEdge) {
+            inViewThicknessEdge = (windowgeometry.bottom() == viewInfo->absoluteGeometry().top() - 1);
+        } else if (viewInfo->location() == Plasma::Types::LeftEdge) {
+            inViewThicknessEdge = (windowgeometry.x() == viewInfo->absoluteGeometry().right() + 1);
+        } else if (viewInfo->location() == Plasma::Types::RightEdge) {
+            inViewThicknessEdge = (windowgeometry.right() == viewInfo->absoluteGeometry().left() - 1);
         }
 
-        if (view->formFactor() == Plasma::Types::Horizontal) {
-            int yCenter = view->absoluteGeometry().center().y();
+        if (viewInfo->formFactor() == Plasma::Types::Horizontal) {
+            int yCenter = viewInfo->absoluteGeometry().center().y();
 
             QPoint leftChecker(windowgeometry.left(), yCenter);
             QPoint rightChecker(windowgeometry.right(), yCenter);
 
-            bool fulloverlap = (windowgeometry.left()<=view->absoluteGeometry().left()) && (windowgeometry.right()>=view->absoluteGeometry().right());
+            bool fulloverlap = (windowgeometry.left()<=viewInfo->absoluteGeometry().left()) && (windowgeometry.right()>=viewInfo->absoluteGeometry().right());
 
-            inViewLengthBoundaries = fulloverlap || view->absoluteGeometry().contains(leftChecker) || view->absoluteGeometry().contains(rightChecker);
-        } else if (view->formFactor() == Plasma::Types::Vertical) {
-            int xCenter = view->absoluteGeometry().center().x();
+            inViewLengthBoundaries = fulloverlap || viewInfo->absoluteGeometry().contains(leftChecker) || viewInfo->absoluteGeometry().contains(rightChecker);
+        } else if (viewInfo->formFactor() == Plasma::Types::Vertical) {
+            int xCenter = viewInfo->absoluteGeometry().center().x();
 
             QPoint topChecker(xCenter, windowgeometry.top());
             QPoint bottomChecker(xCenter, windowgeometry.bottom());
 
-            bool fulloverlap = (windowgeometry.top()<=view->absoluteGeometry().top()) && (windowgeometry.bottom()>=view->absoluteGeometry().bottom());
+            bool fulloverlap = (windowgeometry.top()<=viewInfo->absoluteGeometry().top()) && (windowgeometry.bottom()>=viewInfo->absoluteGeometry().bottom());
 
-            inViewLengthBoundaries = fulloverlap || view->absoluteGeometry().contains(topChecker) || view->absoluteGeometry().contains(bottomChecker);
+            inViewLengthBoundaries = fulloverlap || viewInfo->absoluteGeometry().contains(topChecker) || viewInfo->absoluteGeometry().contains(bottomChecker);
         }
     }
 
     return (inViewThicknessEdge && inViewLengthBoundaries);
 }
 
-bool Windows::isTouchingViewEdge(Latte::View *view, const WindowInfoWrap &winfo)
+bool Windows::isTouchingViewEdge(TrackedViewInfo *viewInfo, const WindowInfoWrap &winfo)
 {
     if (winfo.isValid() &&  !winfo.isMinimized()) {
-        return isTouchingViewEdge(view, winfo.geometry());
+        return isTouchingViewEdge(viewInfo, winfo.geometry());
     }
 
     return false;
 }
 
-void Windows::cleanupFaultyWindows()
+void Windows::updateAvailableScreenGeometries()
 {
-    for (const auto &key : m_windows.keys()) {
-        auto winfo = m_windows[key];
-
-        //! garbage windows removing
-        if (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0)) {
-            //qDebug() << "Faulty Geometry ::: " << winfo.wid();
-            m_windows.remove(key);
-        }
+    //! window interfaces without a corona, e.g. the synthetic one, have no available screen geometries
+    if (!m_wm->corona()) {
+        return;
     }
-}
-
 
-void Windows::updateAvailableScreenGeometries()
-{
     for (const auto view : m_views.keys()) {
         if (m_views[view]->enabled()) {
             int currentscrid = view->positioner()->currentScreenId();
@@ -810,6 +1431,7 @@ void Windows::updateAvailableScreenGeometries()
             if (tempAvailableScreenGeometry != m_views[view]->availableScreenGeometry()) {
                 m_views[view]->setAvailableScreenGeometry(tempAvailableScreenGeometry);
                 updateHints(view);
+                scheduleExtraViewHints(view);
             }
         }
     }
@@ -817,46 +1439,160 @@ void Windows::updateAvailableScreenGeometries()
 
 void Windows::updateAllHints()
 {
+    updateCurrentDesktopActivity();
+
+    //! views and layouts accumulators that are fed from a single pass over the visible windows
+    struct ViewPass
+    {
+        //! null for synthetic views, their hints are never assigned
+        Latte::View *view;
+        TrackedViewInfo *info;
+        QRect strip;
+        bool touchingRequired;
+    };
+
+    QList<ViewPass> viewPasses;
+    QList<Latte::Layout::GenericLayout *> layouts;
+
+    for (auto it = m_views.constBegin(); it != m_views.constEnd(); ++it) {
+        if (!it.value()->enabled() || !it.value()->isTrackingCurrentActivity()) {
+            continue;
+        }
+
+        m_statistics.addViewHintsUpdate(it.key()->containment()->id());
+        it.value()->clearContributions();
+
+        //! the strip is one pixel larger in order to include edge touching windows
+        TrackedGeneralInfo::WindowHints required = it.value()->requiredWindowHints();
+        viewPasses << ViewPass{it.key(),
+                               it.value(),
+                               it.value()->absoluteGeometry().adjusted(-1, -1, 1, 1),
+                               bool(required & (TrackedGeneralInfo::TouchingHint | TrackedGeneralInfo::TouchingEdgeHint))};
+    }
+
+    for (const auto viewInfo : m_syntheticViews) {
+        viewInfo->clearContributions();
+
+        TrackedGeneralInfo::WindowHints required = viewInfo->requiredWindowHints();
+        viewPasses << ViewPass{nullptr,
+                               viewInfo,
+                               viewInfo->absoluteGeometry().adjusted(-1, -1, 1, 1),
+                               bool(required & (TrackedGeneralInfo::TouchingHint | TrackedGeneralInfo::TouchingEdgeHint))};
+    }
+
+    for (auto it = m_layouts.constBegin(); it != m_layouts.constEnd(); ++it) {
+        if (!it.value()->enabled() || !it.value()->isTrackingCurrentActivity()) {
+            continue;
+        }
+
+        m_statistics.addLayoutHintsUpdate(it.key()->name());
+        it.value()->clearContributions();
+        layouts << it.key();
+    }
+
+    if (viewPasses.isEmpty() && layouts.isEmpty()) {
+        return;
+    }
+
+    //! the common window predicates are evaluated once for all consumers
+    for (const auto &key : m_windowBuckets.visibleWindows()) {
+        auto it = m_windows.constFind(key);
+
+        if (it == m_windows.constEnd()) {
+            continue;
+        }
+
+        const WindowInfoWrap &winfo = it.value();
+        m_statistics.addScannedWindow();
+
+        if (!isTrackableWindow(winfo)) {
+            continue;
+        }
+
+        bool active = isActive(winfo);
+        bool activeOrMaximized = active || winfo.isMaximized();
+
+        for (const auto layout : layouts) {
+            m_layouts[layout]->setContribution(winfo.wid(), trackableWindowHints(layout, winfo, active));
+        }
+
+        for (const auto &pass : viewPasses) {
+            //! only windows that are touching the view strip, active or maximized windows can provide hints
+            if (!activeOrMaximized && (!pass.touchingRequired || !pass.strip.intersects(winfo.geometry()))) {
+                continue;
+            }
+
+            pass.info->setContribution(winfo.wid(), trackableWindowHints(pass.info, winfo, active));
+        }
+    }
+
+    for (const auto &pass : viewPasses) {
+        if (pass.view) {
+            assignHints(pass.view);
+        }
+    }
+
+    for (const auto layout : layouts) {
+        assignHints(layout);
+    }
+}
+
+void Windows::updateWindowHints(const QList<WindowId> &wids)
+{
+    if (wids.isEmpty()) {
+        return;
+    }
+
     for (const auto view : m_views.keys()) {
-        updateHints(view);
+        updateHints(view, wids);
     }
 
-    for (const auto layout : m_layouts.keys()) {
-        updateHints(layout);
+    if (!m_syntheticViews.isEmpty()) {
+        updateCurrentDesktopActivity();
+
+        for (const auto viewInfo : m_syntheticViews) {
+            updateContributions(viewInfo, wids);
+        }
     }
 
-    if (!m_extraViewHintsTimer.isActive()) {
-        m_extraViewHintsTimer.start();
+    for (const auto layout : m_layouts.keys()) {
+        updateHints(layout, wids);
     }
 }
 
 void Windows::updateExtraViewHints()
 {
-    for (const auto horView : m_views.keys()) {
-        if (!m_views.contains(horView) || !m_views[horView]->enabled() || !m_views[horView]->isTrackingCurrentActivity()) {
+    //! only horizontal views whose own state or their screen vertical views changed are evaluated
+    QSet<Latte::View *> horViews = m_extraViewHintsPending;
+    m_extraViewHintsPending.clear();
+
+    for (const auto horView : horViews) {
+        if (!m_views.contains(horView) || !m_views[horView]->enabled() || !m_views[horView]->isTrackingCurrentActivity()
+                || !m_views[horView]->isRequested(TrackedViewInfo::TouchingBusyVerticalViewHint)
+                || !m_viewScreenEdges.contains(horView)) {
             continue;
         }
 
         if (horView->formFactor() == Plasma::Types::Horizontal) {
             bool touchingBusyVerticalView{false};
+            int screen = m_viewScreenEdges[horView].first;
+
+            QList<Latte::View *> verViews = m_screenEdgeViews.value(ScreenEdge(screen, Plasma::Types::LeftEdge))
+                    + m_screenEdgeViews.value(ScreenEdge(screen, Plasma::Types::RightEdge));
 
-            for (const auto verView : m_views.keys()) {
+            for (const auto verView : verViews) {
                 if (!m_views.contains(verView) || !m_views[verView]->enabled() || !m_views[verView]->isTrackingCurrentActivity()) {
                     continue;
                 }
 
-                bool sameScreen = (verView->positioner()->currentScreenId() == horView->positioner()->currentScreenId());
+                bool hasEdgeTouch = isTouchingViewEdge(m_views[horView], verView->absoluteGeometry());
 
-                if (verView->formFactor() == Plasma::Types::Vertical && sameScreen) {
-                    bool hasEdgeTouch = isTouchingViewEdge(horView, verView->absoluteGeometry());
+                bool topTouch = horView->location() == Plasma::Types::TopEdge && verView->isTouchingTopViewAndIsBusy() && hasEdgeTouch;
+                bool bottomTouch = horView->location() == Plasma::Types::BottomEdge && verView->isTouchingBottomViewAndIsBusy() && hasEdgeTouch;
 
-                    bool topTouch = horView->location() == Plasma::Types::TopEdge && verView->isTouchingTopViewAndIsBusy() && hasEdgeTouch;
-                    bool bottomTouch = horView->location() == Plasma::Types::BottomEdge && verView->isTouchingBottomViewAndIsBusy() && hasEdgeTouch;
-
-                    if (topTouch || bottomTouch) {
-                        touchingBusyVerticalView = true;
-                        break;
-                    }
+                if (topTouch || bottomTouch) {
+                    touchingBusyVerticalView = true;
+                    break;
                 }
             }
 
@@ -867,14 +1603,167 @@ void Windows::updateExtraViewHints()
     }
 }
 
+TrackedGeneralInfo::WindowHints Windows::windowHints(TrackedViewInfo *viewInfo, const WindowInfoWrap &winfo)
+{
+    m_statistics.addScannedWindow();
+
+    TrackedGeneralInfo::WindowHints hints{TrackedGeneralInfo::NoHint};
+
+    if (!isTrackableWindow(winfo)) {
+        return hints;
+    }
+
+    return trackableWindowHints(viewInfo, winfo, isActive(winfo));
+}
+
+TrackedGeneralInfo::WindowHints Windows::trackableWindowHints(TrackedViewInfo *viewInfo, const WindowInfoWrap &winfo, bool active)
+{
+    m_statistics.addHintsEvaluation();
+
+    TrackedGeneralInfo::WindowHints hints{TrackedGeneralInfo::NoHint};
+    TrackedGeneralInfo::WindowHints required = viewInfo->requiredWindowHints();
+
+    if (active) {
+        hints |= TrackedGeneralInfo::ActiveHint;
+    }
+
+    if (isActiveInViewScreen(viewInfo, winfo)) {
+        hints |= TrackedGeneralInfo::ActiveInScreenHint;
+    }
+
+    if (required.testFlag(TrackedGeneralInfo::MaximizedHint) && isMaximizedInViewScreen(viewInfo, winfo)) {
+        hints |= TrackedGeneralInfo::MaximizedHint;
+    }
+
+    if (required.testFlag(TrackedGeneralInfo::TouchingHint) && isTouchingView(viewInfo, winfo)) {
+        hints |= TrackedGeneralInfo::TouchingHint;
+    }
+
+    if (required.testFlag(TrackedGeneralInfo::TouchingEdgeHint) && isTouchingViewEdge(viewInfo, winfo)) {
+        hints |= TrackedGeneralInfo::TouchingEdgeHint;
+    }
+
+    return hints;
+}
+
+TrackedGeneralInfo::WindowHints Windows::windowHints(Latte::Layout::GenericLayout *layout, const WindowInfoWrap &winfo)
+{
+    m_statistics.addScannedWindow();
+
+    TrackedGeneralInfo::WindowHints hints{TrackedGeneralInfo::NoHint};
+
+    if (!isTrackableWindow(winfo)) {
+        return hints;
+    }
+
+    return trackableWindowHints(layout, winfo, isActive(winfo));
+}
+
+TrackedGeneralInfo::WindowHints Windows::trackableWindowHints(Latte::Layout::GenericLayout *layout, const WindowInfoWrap &winfo, bool active)
+{
+    Q_UNUSED(layout)
+
+    m_statistics.addHintsEvaluation();
+
+    TrackedGeneralInfo::WindowHints hints{TrackedGeneralInfo::NoHint};
+
+    if (active) {
+        hints |= TrackedGeneralInfo::ActiveHint;
+    }
+
+    if (winfo.isMaximized()) {
+        hints |= TrackedGeneralInfo::MaximizedHint;
+    }
+
+    return hints;
+}
+
 void Windows::updateHints(Latte::View *view)
 {
     if (!m_views.contains(view) || !m_views[view]->enabled() || !m_views[view]->isTrackingCurrentActivity()) {
         return;
     }
 
-    bool foundActive{false};
-    bool foundActiveInCurScreen{false};
+    updateCurrentDesktopActivity();
+
+    m_statistics.addViewHintsUpdate(view->containment()->id());
+
+    TrackedViewInfo *viewInfo = m_views[view];
+    viewInfo->clearContributions();
+
+    //! only windows that are touching the view strip, active or maximized windows can
+    //! provide hints, the strip is one pixel larger in order to include edge touching windows
+    QList<WindowId> candidates = m_activeAndMaximizedWindows;
+    TrackedGeneralInfo::WindowHints required = viewInfo->requiredWindowHints();
+
+    if (required & (TrackedGeneralInfo::TouchingHint | TrackedGeneralInfo::TouchingEdgeHint)) {
+        QRect viewStrip = viewInfo->absoluteGeometry().adjusted(-1, -1, 1, 1);
+        candidates += m_windowsGrid.windows(viewStrip);
+    }
+
+    //! active or maximized windows touching the view are found twice
+    QSet<WindowKey> evaluated;
+
+    for (const auto &wid : candidates) {
+        WindowKey key(wid);
+
+        if (evaluated.contains(key)) {
+            continue;
+        }
+
+        evaluated.insert(key);
+
+        if (m_windows.contains(key)) {
+            viewInfo->setContribution(wid, windowHints(viewInfo, m_windows[key]));
+        }
+    }
+
+    assignHints(view);
+}
+
+void Windows::updateHints(Latte::View *view, const QList<WindowId> &wids)
+{
+    if (!m_views.contains(view) || !m_views[view]->enabled() || !m_views[view]->isTrackingCurrentActivity()) {
+        return;
+    }
+
+    updateCurrentDesktopActivity();
+
+    m_statistics.addViewHintsUpdate(view->containment()->id());
+
+    if (updateContributions(m_views[view], wids)) {
+        assignHints(view);
+    }
+}
+
+bool Windows::updateContributions(TrackedViewInfo *viewInfo, const QList<WindowId> &wids)
+{
+    bool reassign{false};
+
+    for (const auto &wid : wids) {
+        TrackedGeneralInfo::WindowHints hints{TrackedGeneralInfo::NoHint};
+
+        if (m_windows.contains(wid)) {
+            hints = windowHints(viewInfo, m_windows[wid]);
+        }
+
+        bool changed = viewInfo->setContribution(wid, hints);
+
+        //! touching windows must be always re-assigned because their active window group
+        //! can change even though their contribution remains the same
+        if (changed || hints.testFlag(TrackedGeneralInfo::TouchingHint)) {
+            reassign = true;
+        }
+    }
+
+    return reassign;
+}
+
+void Windows::assignHints(Latte::View *view)
+{
+    TrackedViewInfo *viewInfo = m_views[view];
+
+    bool foundActiveInCurScreen = (viewInfo->contributors(TrackedGeneralInfo::ActiveInScreenHint) > 0);
     bool foundActiveTouchInCurScreen{false};
     bool foundActiveEdgeTouchInCurScreen{false};
     bool foundTouchInCurScreen{false};
@@ -883,10 +1772,6 @@ void Windows::updateHints(Latte::View *view)
 
     bool foundActiveGroupTouchInCurScreen{false};
 
-    //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
-    //! maybe a garbage collector here is a good idea!!!
-    bool existsFaultyWindow{false};
-
     WindowId maxWinId;
     WindowId activeWinId;
     WindowId touchWinId;
@@ -894,108 +1779,69 @@ void Windows::updateHints(Latte::View *view)
     WindowId activeTouchWinId;
     WindowId activeTouchEdgeWinId;
 
-    //qDebug() << " -- TRACKING REPORT (SCREEN)--";
-
-    //! First Pass
-    for (const auto &winfo : m_windows) {
-        if (!existsFaultyWindow && (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0))) {
-            existsFaultyWindow = true;
-        }
+    const QMap<WindowId, TrackedGeneralInfo::WindowHints> &contributions = viewInfo->contributions();
 
-        if ( !m_wm->inCurrentDesktopActivity(winfo)
-             || m_wm->hasBlockedTracking(winfo.wid())
-             || winfo.isMinimized()) {
-            continue;
-        }
-
-        //qDebug() << " _ _ _ ";
-        //qDebug() << "TRACKING | WINDOW INFO :: " << winfo.wid() << " _ " << winfo.appName() << " _ " << winfo.geometry() << " _ " << winfo.display();
-
-        if (isActive(winfo)) {
-            foundActive = true;
-        }
+    //! only windows that contribute at least one hint are checked
+    for (auto it = contributions.constBegin(); it != contributions.constEnd(); ++it) {
+        const WindowId &wid = it.key();
+        const TrackedGeneralInfo::WindowHints &hints = it.value();
+        bool isActive = hints.testFlag(TrackedGeneralInfo::ActiveHint);
 
-        if (isActiveInViewScreen(view, winfo)) {
-            foundActiveInCurScreen = true;
-            activeWinId = winfo.wid();
+        if (hints.testFlag(TrackedGeneralInfo::ActiveInScreenHint)) {
+            activeWinId = wid;
         }
 
         //! Maximized windows flags
-        if ((winfo.isActive() && isMaximizedInViewScreen(view, winfo)) //! active maximized windows have higher priority than the rest maximized windows
-                || (!foundMaximizedInCurScreen && isMaximizedInViewScreen(view, winfo))) {
+        if (hints.testFlag(TrackedGeneralInfo::MaximizedHint)
+                && (isActive || !foundMaximizedInCurScreen)) { //! active maximized windows have higher priority than the rest maximized windows
             foundMaximizedInCurScreen = true;
-            maxWinId = winfo.wid();
+            maxWinId = wid;
         }
 
         //! Touching windows flags
-
-        bool touchingViewEdge = isTouchingViewEdge(view, winfo);
-        bool touchingView =  isTouchingView(view, winfo);
-
-        if (touchingView) {
-            if (winfo.isActive()) {
+        if (hints.testFlag(TrackedGeneralInfo::TouchingHint)) {
+            if (isActive) {
                 foundActiveTouchInCurScreen = true;
-                activeTouchWinId = winfo.wid();
+                activeTouchWinId = wid;
             } else {
                 foundTouchInCurScreen = true;
-                touchWinId = winfo.wid();
+                touchWinId = wid;
             }
         }
 
-        if (touchingViewEdge) {
-            if (winfo.isActive()) {
+        if (hints.testFlag(TrackedGeneralInfo::TouchingEdgeHint)) {
+            if (isActive) {
                 foundActiveEdgeTouchInCurScreen = true;
-                activeTouchEdgeWinId = winfo.wid();
+                activeTouchEdgeWinId = wid;
             } else {
                 foundTouchEdgeInCurScreen = true;
-                touchEdgeWinId = winfo.wid();
+                touchEdgeWinId = wid;
             }
         }
-
-        //qDebug() << "TRACKING |       ACTIVE:"<< foundActive <<  " ACT_CUR_SCR:" << foundTouchInCurScreen << " MAXIM:"<<foundMaximizedInCurScreen;
-        //qDebug() << "TRACKING |       TOUCHING VIEW EDGE:"<< touchingViewEdge << " TOUCHING VIEW:" << foundTouchInCurScreen;
-    }
-
-    if (existsFaultyWindow) {
-        cleanupFaultyWindows();
     }
 
     //! PASS 2
-    if (foundActiveInCurScreen && !foundActiveTouchInCurScreen) {
-        //! Second Pass to track also Child windows if needed
-
-        //qDebug() << "Windows Array...";
-        //for (const auto &winfo : m_windows) {
-        //    qDebug() << " - " << winfo.wid() << " - " << winfo.isValid() << " - " << winfo.display() << " - " << winfo.geometry() << " parent : " << winfo.parentId();
-        //}
-        //qDebug() << " - - - - - ";
-
-        WindowInfoWrap activeInfo = m_windows[activeWinId];
-        WindowId mainWindowId = activeInfo.isChildWindow() ? activeInfo.parentId() : activeWinId;
-
-        for (const auto &winfo : m_windows) {
-            if (!m_wm->inCurrentDesktopActivity(winfo)
-                    || m_wm->hasBlockedTracking(winfo.wid())
-                    || winfo.isMinimized()) {
-                continue;
-            }
+    if (foundActiveInCurScreen && !foundActiveTouchInCurScreen && viewInfo->contributors(TrackedGeneralInfo::TouchingHint) > 0) {
+        //! Second Pass to track also Child windows if needed, only the active window group
+        //! meaning the main window and its children is checked through the transient index
 
-            bool inActiveGroup = (winfo.wid() == mainWindowId || winfo.parentId() == mainWindowId);
+        WindowInfoWrap activeInfo = m_windows.value(activeWinId);
+        WindowKey mainWindow = activeInfo.isChildWindow() ? WindowKey(activeInfo.parentId()) : WindowKey(activeWinId);
 
-            //! consider only windows that belong to active window group meaning the main window
-            //! and its children
-            if (!inActiveGroup) {
-                continue;
-            }
+        QList<WindowId> activeGroup = m_childWindows.value(mainWindow);
+
+        if (m_windows.contains(mainWindow)) {
+            activeGroup.prepend(m_windows[mainWindow].wid());
+        }
 
-            if (isTouchingView(view, winfo)) {
+        for (const auto &wid : activeGroup) {
+            if (viewInfo->contribution(wid).testFlag(TrackedGeneralInfo::TouchingHint)) {
                 foundActiveGroupTouchInCurScreen = true;
                 break;
             }
         }
     }
 
-
     //! HACK: KWin Effects such as ShowDesktop have no way to be identified and as such
     //! create issues with identifying properly touching and maximized windows. BUT when
     //! they are enabled then NO ACTIVE window is found. This is a way to identify these
@@ -1006,35 +1852,59 @@ void Windows::updateHints(Latte::View *view)
     //foundMaximizedInCurScreen = foundMaximizedInCurScreen && foundActive;
     //foundTouchInCurScreen = foundTouchInCurScreen && foundActive;
 
-    //! assign flags
-    setExistsWindowActive(view, foundActiveInCurScreen);
-    setActiveWindowTouching(view, foundActiveTouchInCurScreen || foundActiveGroupTouchInCurScreen);
-    setActiveWindowTouchingEdge(view, foundActiveEdgeTouchInCurScreen);
-    setActiveWindowMaximized(view, (maxWinId.toInt()>0 && (maxWinId == activeTouchWinId || maxWinId == activeTouchEdgeWinId)));
-    setExistsWindowMaximized(view, foundMaximizedInCurScreen);
-    setExistsWindowTouching(view, (foundTouchInCurScreen || foundActiveTouchInCurScreen || foundActiveGroupTouchInCurScreen));
-    setExistsWindowTouchingEdge(view, (foundActiveEdgeTouchInCurScreen || foundTouchEdgeInCurScreen));
+    //! assign flags, only the ones that are requested from the view consumers
+    if (viewInfo->isRequested(TrackedViewInfo::ExistsWindowActiveHint)) {
+        setExistsWindowActive(view, foundActiveInCurScreen);
+    }
+
+    if (viewInfo->isRequested(TrackedViewInfo::ActiveWindowTouchingHint)) {
+        setActiveWindowTouching(view, foundActiveTouchInCurScreen || foundActiveGroupTouchInCurScreen);
+    }
+
+    if (viewInfo->isRequested(TrackedViewInfo::ActiveWindowTouchingEdgeHint)) {
+        setActiveWindowTouchingEdge(view, foundActiveEdgeTouchInCurScreen);
+    }
+
+    if (viewInfo->isRequested(TrackedViewInfo::ActiveWindowMaximizedHint)) {
+        setActiveWindowMaximized(view, (maxWinId.toInt()>0 && (maxWinId == activeTouchWinId || maxWinId == activeTouchEdgeWinId)));
+    }
+
+    if (viewInfo->isRequested(TrackedViewInfo::ExistsWindowMaximizedHint)) {
+        setExistsWindowMaximized(view, foundMaximizedInCurScreen);
+    }
+
+    if (viewInfo->isRequested(TrackedViewInfo::ExistsWindowTouchingHint)) {
+        setExistsWindowTouching(view, (foundTouchInCurScreen || foundActiveTouchInCurScreen || foundActiveGroupTouchInCurScreen));
+    }
+
+    if (viewInfo->isRequested(TrackedViewInfo::ExistsWindowTouchingEdgeHint)) {
+        setExistsWindowTouchingEdge(view, (foundActiveEdgeTouchInCurScreen || foundTouchEdgeInCurScreen));
+    }
 
     //! update color schemes for active and touching windows
-    setActiveWindowScheme(view, (foundActiveInCurScreen ? m_wm->schemesTracker()->schemeForWindow(activeWinId) : nullptr));
-
-    if (foundActiveTouchInCurScreen) {
-        setTouchingWindowScheme(view, m_wm->schemesTracker()->schemeForWindow(activeTouchWinId));
-    } else if (foundActiveEdgeTouchInCurScreen) {
-        setTouchingWindowScheme(view, m_wm->schemesTracker()->schemeForWindow(activeTouchEdgeWinId));
-    } else if (foundMaximizedInCurScreen) {
-        setTouchingWindowScheme(view, m_wm->schemesTracker()->schemeForWindow(maxWinId));
-    } else if (foundTouchInCurScreen) {
-        setTouchingWindowScheme(view, m_wm->schemesTracker()->schemeForWindow(touchWinId));
-    } else if (foundTouchEdgeInCurScreen) {
-        setTouchingWindowScheme(view, m_wm->schemesTracker()->schemeForWindow(touchEdgeWinId));
-    } else {
-        setTouchingWindowScheme(view, nullptr);
+    if (viewInfo->isRequested(TrackedViewInfo::ActiveWindowSchemeHint)) {
+        setActiveWindowScheme(view, (foundActiveInCurScreen ? m_wm->schemesTracker()->schemeForWindow(activeWinId) : nullptr));
+    }
+
+    if (viewInfo->isRequested(TrackedViewInfo::TouchingWindowSchemeHint)) {
+        if (foundActiveTouchInCurScreen) {
+            setTouchingWindowScheme(view, m_wm->schemesTracker()->schemeForWindow(activeTouchWinId));
+        } else if (foundActiveEdgeTouchInCurScreen) {
+            setTouchingWindowScheme(view, m_wm->schemesTracker()->schemeForWindow(activeTouchEdgeWinId));
+        } else if (foundMaximizedInCurScreen) {
+            setTouchingWindowScheme(view, m_wm->schemesTracker()->schemeForWindow(maxWinId));
+        } else if (foundTouchInCurScreen) {
+            setTouchingWindowScheme(view, m_wm->schemesTracker()->schemeForWindow(touchWinId));
+        } else if (foundTouchEdgeInCurScreen) {
+            setTouchingWindowScheme(view, m_wm->schemesTracker()->schemeForWindow(touchEdgeWinId));
+        } else {
+            setTouchingWindowScheme(view, nullptr);
+        }
     }
 
     //! update LastActiveWindow
     if (foundActiveInCurScreen) {
-        m_views[view]->setActiveWindow(activeWinId);
+        viewInfo->setActiveWindow(activeWinId);
     }
 
     //! Debug
@@ -1047,53 +1917,82 @@ void Windows::updateHints(Latte::View *view)
     //qDebug() << "TRACKING | existsActiveGroupTouching: " << foundActiveGroupTouchInCurScreen;
 }
 
-void Windows::updateHints(Latte::Layout::GenericLayout *layout) {
+void Windows::updateHints(Latte::Layout::GenericLayout *layout)
+{
     if (!m_layouts.contains(layout) || !m_layouts[layout]->enabled() || !m_layouts[layout]->isTrackingCurrentActivity()) {
         return;
     }
 
-    bool foundActive{false};
-    bool foundActiveMaximized{false};
-    bool foundMaximized{false};
+    updateCurrentDesktopActivity();
 
-    //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
-    //! maybe a garbage collector here is a good idea!!!
-    bool existsFaultyWindow{false};
+    m_statistics.addLayoutHintsUpdate(layout->name());
 
-    WindowId activeWinId;
-    WindowId maxWinId;
+    TrackedLayoutInfo *layoutInfo = m_layouts[layout];
+    layoutInfo->clearContributions();
 
-    for (const auto &winfo : m_windows) {
-        if (!existsFaultyWindow && (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0))) {
-            existsFaultyWindow = true;
-        }
+    //! windows of other desktops and activities do not provide any hints
+    for (const auto &key : m_windowBuckets.visibleWindows()) {
+        auto it = m_windows.constFind(key);
 
-        if (!m_wm->inCurrentDesktopActivity(winfo)
-                || m_wm->hasBlockedTracking(winfo.wid())
-                || winfo.isMinimized()) {
-            continue;
+        if (it != m_windows.constEnd()) {
+            layoutInfo->setContribution(it.value().wid(), windowHints(layout, it.value()));
         }
+    }
 
-        if (isActive(winfo)) {
-            foundActive = true;
-            activeWinId = winfo.wid();
+    assignHints(layout);
+}
 
-            if (winfo.isMaximized() && !winfo.isMinimized()) {
-                foundActiveMaximized = true;
-                maxWinId = winfo.wid();
-            }
+void Windows::updateHints(Latte::Layout::GenericLayout *layout, const QList<WindowId> &wids)
+{
+    if (!m_layouts.contains(layout) || !m_layouts[layout]->enabled() || !m_layouts[layout]->isTrackingCurrentActivity()) {
+        return;
+    }
+
+    updateCurrentDesktopActivity();
+
+    m_statistics.addLayoutHintsUpdate(layout->name());
+
+    bool reassign{false};
+
+    for (const auto &wid : wids) {
+        TrackedGeneralInfo::WindowHints hints{TrackedGeneralInfo::NoHint};
+
+        if (m_windows.contains(wid)) {
+            hints = windowHints(layout, m_windows[wid]);
         }
 
-        if (!foundActiveMaximized && winfo.isMaximized() && !winfo.isMinimized()) {
-            foundMaximized = true;
-            maxWinId = winfo.wid();
+        if (m_layouts[layout]->setContribution(wid, hints)) {
+            reassign = true;
         }
+    }
 
-        //qDebug() << "window geometry ::: " << winfo.geometry();
+    if (reassign) {
+        assignHints(layout);
     }
+}
+
+void Windows::assignHints(Latte::Layout::GenericLayout *layout)
+{
+    TrackedLayoutInfo *layoutInfo = m_layouts[layout];
 
-    if (existsFaultyWindow) {
-        cleanupFaultyWindows();
+    bool foundActive = (layoutInfo->contributors(TrackedGeneralInfo::ActiveHint) > 0);
+    bool foundActiveMaximized{false};
+    bool foundMaximized = (layoutInfo->contributors(TrackedGeneralInfo::MaximizedHint) > 0);
+
+    WindowId activeWinId;
+
+    const QMap<WindowId, TrackedGeneralInfo::WindowHints> &contributions = layoutInfo->contributions();
+
+    if (foundActive) {
+        for (auto it = contributions.constBegin(); it != contributions.constEnd(); ++it) {
+            if (it.value().testFlag(TrackedGeneralInfo::ActiveHint)) {
+                activeWinId = it.key();
+
+                if (it.value().testFlag(TrackedGeneralInfo::MaximizedHint)) {
+                    foundActiveMaximized = true;
+                }
+            }
+        }
     }
 
     //! HACK: KWin Effects such as ShowDesktop have no way to be identified and as such
@@ -1116,7 +2015,7 @@ void Windows::updateHints(Latte::Layout::GenericLayout *layout) {
 
     //! update LastActiveWindow
     if (foundActive) {
-        m_layouts[layout]->setActiveWindow(activeWinId);
+        layoutInfo->setActiveWindow(activeWinId);
     }
 
     //! Debug
@@ -22,13 +22,21 @@
 
 // local
 #include <coretypes.h>
+#include "geometrygrid.h"
+#include "statistics.h"
+#include "trackedgeneralinfo.h"
+#include "trackedviewinfo.h"
+#include "windowbuckets.h"
 #include "../windowinfowrap.h"
 
 // Qt
 #include <QObject>
 
+#include <QElapsedTimer>
 #include <QHash>
 #include <QMap>
+#include <QPair>
+#include <QSet>
 #include <QTimer>
 
 
@@ -66,6 +74,10 @@ public:
     bool enabled(Latte::View *view);
     void setEnabled(Latte::View *view, const bool enabled);
 
+    //! hints that the view consumers are currently using, only those are evaluated
+    TrackedViewInfo::ViewHints requestedHints(Latte::View *view) const;
+    void setRequestedHints(Latte::View *view, const TrackedViewInfo::ViewHints &hints);
+
     bool activeWindowMaximized(Latte::View *view) const;
     bool activeWindowTouching(Latte::View *view) const;
     bool activeWindowTouchingEdge(Latte::View *view) const;
@@ -86,14 +98,40 @@ public:
     SchemeColors *activeWindowScheme(Latte::Layout::GenericLayout *layout) const;
     LastActiveWindow *lastActiveWindow(Latte::Layout::GenericLayout *layout);
 
+    //! true when any tracked view or layout references the scheme
+    bool isSchemeInUse(SchemeColors *scheme) const;
+
     //! Windows management
     bool isValidFor(const WindowId &wid) const;
     QIcon iconFor(const WindowId &wid);
     QString appNameFor(const WindowId &wid);
     WindowInfoWrap infoFor(const WindowId &wid) const;
+    QList<WindowId> windows() const;
 
     AbstractWindowInterface *wm();
 
+    //! window system events statistics
+    quint64 eventsReceived() const;
+    quint64 eventsMerged() const;
+    quint64 hintsEvaluated() const;
+
+    //! runtime counters and latency histograms as "key=value" entries
+    QStringList statistics() const;
+    void resetStatistics();
+    void addLastActiveWindowUpdate(int changedFields, int suppressedFields);
+    //! time in nanoseconds from the last batch processing until its window information was evaluated
+    qint64 lastEventsBatchDuration() const;
+
+    //! pending window system events are evaluated immediately instead of after the batching interval,
+    //! it is used from benchmarks in order to measure only the tracking cost
+    void flushEventsBatch();
+    //! views without a window are tracked in order to measure the windows hints evaluation from benchmarks,
+    //! their hints are evaluated but they are never assigned
+    void addSyntheticView(const QRect &absoluteGeometry, const QRect &screenGeometry, const Plasma::Types::Location &location);
+    void removeSyntheticViews();
+    //! true when window system events are collected or evaluated and consumers have not been informed yet
+    bool hasPendingEvents() const;
+
 signals:
     //! Views
     void enabledChanged(const Latte::View *view);
@@ -125,6 +163,11 @@ signals:
 
     void applicationDataChanged(const WindowId &wid);
 
+    //! the collected events became a batch whose window information is requested
+    void eventsBatchStarted();
+    //! all the events of a batch have been evaluated and consumers have been informed
+    void eventsBatchFinished();
+
 private slots:
     void updateAvailableScreenGeometries();
 
@@ -134,17 +177,34 @@ private slots:
     void updateRelevantLayouts();
     void updateExtraViewHints();
 
+    void processEventsBatch();
+    void finishEventsBatch(const QList<WindowId> &wids, const QList<WindowInfoWrap> &infos);
+    void fetchInfosTimedOut();
+
 private:
     void init();
     void initLayoutHints(Latte::Layout::GenericLayout *layout);
     void initViewHints(Latte::View *view);
-    void cleanupFaultyWindows();
 
+    //! full rescan of all windows for all views and layouts, it is used only when the
+    //! tracking context changes e.g. desktop, activity or screen geometries
     void updateAllHints();
+    //! incremental update, only the provided windows contributions are re-evaluated
+    void updateWindowHints(const QList<WindowId> &wids);
+
+    void scheduleEventsBatch();
 
     //! Views
     void updateHints(Latte::View *view);
+    void updateHints(Latte::View *view, const QList<WindowId> &wids);
+    //! returns true when the view hints must be assigned again
+    bool updateContributions(TrackedViewInfo *viewInfo, const QList<WindowId> &wids);
+    void assignHints(Latte::View *view);
+
+    //! Layouts
     void updateHints(Latte::Layout::GenericLayout *layout);
+    void updateHints(Latte::Layout::GenericLayout *layout, const QList<WindowId> &wids);
+    void assignHints(Latte::Layout::GenericLayout *layout);
 
     void setActiveWindowMaximized(Latte::View *view, bool activeMaximized);
     void setActiveWindowTouching(Latte::View *view, bool activeTouching);
@@ -164,23 +224,86 @@ private:
     void setActiveWindowScheme(Latte::Layout::GenericLayout *layout, WindowSystem::SchemeColors *scheme);
 
     //! Windows
-    bool intersects(Latte::View *view, const WindowInfoWrap &winfo);
+    void setWindowInfo(const WindowId &wid, const WindowInfoWrap &winfo);
+    void removeWindowInfo(const WindowId &wid);
+    void updateCurrentDesktopActivity();
+
+    //! Views registry
+    void updateScreenEdgeRegistry(Latte::View *view);
+    //! horizontal views that need to re-evaluate their touching busy vertical views
+    void scheduleExtraViewHints(Latte::View *view);
+    void scheduleExtraViewHints(const int &screen);
+    //! a null parent removes the window from the transient index
+    void updateTransientIndex(const WindowId &wid, const WindowKey &parent);
+
+    TrackedGeneralInfo::WindowHints windowHints(TrackedViewInfo *viewInfo, const WindowInfoWrap &winfo);
+    TrackedGeneralInfo::WindowHints windowHints(Latte::Layout::GenericLayout *layout, const WindowInfoWrap &winfo);
+    //! hints of windows that have already passed the common tracking criteria
+    TrackedGeneralInfo::WindowHints trackableWindowHints(TrackedViewInfo *viewInfo, const WindowInfoWrap &winfo, bool active);
+    TrackedGeneralInfo::WindowHints trackableWindowHints(Latte::Layout::GenericLayout *layout, const WindowInfoWrap &winfo, bool active);
+
+    bool intersects(TrackedViewInfo *viewInfo, const WindowInfoWrap &winfo);
+    bool isFaultyWindow(const WindowInfoWrap &winfo) const;
+    bool isTrackableWindow(const WindowInfoWrap &winfo);
     bool isActive(const WindowInfoWrap &winfo);
-    bool isActiveInViewScreen(Latte::View *view, const WindowInfoWrap &winfo);
-    bool isMaximizedInViewScreen(Latte::View *view, const WindowInfoWrap &winfo);
-    bool isTouchingView(Latte::View *view, const WindowSystem::WindowInfoWrap &winfo);
-    bool isTouchingViewEdge(Latte::View *view, const WindowInfoWrap &winfo);
-    bool isTouchingViewEdge(Latte::View *view, const QRect &windowgeometry);
+    bool isActiveInViewScreen(TrackedViewInfo *viewInfo, const WindowInfoWrap &winfo);
+    bool isMaximizedInViewScreen(TrackedViewInfo *viewInfo, const WindowInfoWrap &winfo);
+    bool isTouchingView(TrackedViewInfo *viewInfo, const WindowSystem::WindowInfoWrap &winfo);
+    bool isTouchingViewEdge(TrackedViewInfo *viewInfo, const WindowInfoWrap &winfo);
+    bool isTouchingViewEdge(TrackedViewInfo *viewInfo, const QRect &windowgeometry);
 
 private:
     //! a timer in order to not overload the views extra hints checking because it is not
     //! really needed that often
     QTimer m_extraViewHintsTimer;
 
+    //! window system events are collected and they are evaluated all together
+    //! once per frame, e.g. during desktop switching or session restore
+    QTimer m_eventsBatchTimer;
+    //! window information that is not received in time is requested synchronously,
+    //! in order to not block the tracking of new events forever
+    QTimer m_fetchInfosTimer;
+
+    struct EventsBatch
+    {
+        bool hasEvents{false};
+        bool activeWindowChanged{false};
+        bool activityChanged{false};
+        bool fullUpdate{false};
+        WindowId activeWindow;
+        QList<WindowId> addedWindows;
+        QList<WindowId> changedWindows;
+        QList<WindowId> removedWindows;
+        QMap<WindowId, WindowProperties> changedProperties;
+        //! windows and properties that were requested for the fetching batch
+        QList<WindowId> requestedWindows;
+        QList<WindowProperties> requestedProperties;
+    };
+
+    //! events that are collected for the next batch
+    EventsBatch m_eventsBatch;
+    //! batch whose window information has been requested and is not received yet
+    EventsBatch m_fetchingBatch;
+    bool m_isFetchingInfos{false};
+
+    Statistics m_statistics;
+
+    QElapsedTimer m_eventsBatchElapsed;
+    qint64 m_lastEventsBatchDuration{0};
+
     AbstractWindowInterface *m_wm;
     QHash<Latte::View *, TrackedViewInfo *> m_views;
+    QList<TrackedViewInfo *> m_syntheticViews;
     QHash<Latte::Layout::GenericLayout *, TrackedLayoutInfo *> m_layouts;
 
+    //! screen id and plasma location
+    using ScreenEdge = QPair<int, int>;
+    //! views registry keyed by screen and edge, it is used to identify directly
+    //! the vertical views that are touching top and bottom views
+    QHash<ScreenEdge, QList<Latte::View *>> m_screenEdgeViews;
+    QHash<Latte::View *, ScreenEdge> m_viewScreenEdges;
+    QSet<Latte::View *> m_extraViewHintsPending;
+
     //! Accept only ALWAYSVISIBLE visibility mode
     QList<Latte::Types::Visibility> m_ignoreModes{
         Latte::Types::AutoHide,
@@ -194,7 +317,17 @@ private:
         Latte::Types::SidebarAutoHide
     };
 
-    QMap<WindowId, WindowInfoWrap> m_windows;
+    QHash<WindowKey, WindowInfoWrap> m_windows;
+
+    //! windows partitioned by desktop and activity in order to check only the visible ones
+    WindowBuckets m_windowBuckets;
+    //! windows geometries index in order to check only windows that are close to each view
+    GeometryGrid m_windowsGrid;
+    //! transient index, parent window and its children windows
+    QHash<WindowKey, QList<WindowId>> m_childWindows;
+    QHash<WindowKey, WindowKey> m_parentWindows;
+    //! active and maximized windows provide hints even when they are far away from views
+    QList<WindowId> m_activeAndMaximizedWindows;
 
     //! Some applications delay their application name/icon identification
     //! such as Libreoffice that updates its StartupWMClass after
@@ -202,6 +335,8 @@ private:
     QTimer m_updateApplicationDataTimer;
     QList<WindowId> m_delayedApplicationData;
     QList<WindowId> m_initializedApplicationData;
+    //! windows whose application url was not resolved yet
+    QList<WindowId> m_unresolvedApplicationData;
 };
 
 }
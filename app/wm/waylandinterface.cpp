@@ -22,6 +22,7 @@
 
 // local
 #include <coretypes.h>
+#include "appidentitycache.h"
 #include "../view/positioner.h"
 #include "../view/view.h"
 #include "../view/settings/subconfigview.h"
@@ -149,10 +150,17 @@ void WaylandInterface::initWindowManagement(KWayland::Client::PlasmaWindowManage
 
     m_windowManagement = windowManagement;
 
+    m_windows.clear();
+    m_windowInfos.clear();
+
+    for (auto w : m_windowManagement->windows()) {
+        indexWindow(w);
+    }
+
     connect(m_windowManagement, &PlasmaWindowManagement::windowCreated, this, &WaylandInterface::windowCreatedProxy);
     connect(m_windowManagement, &PlasmaWindowManagement::activeWindowChanged, this, [&]() noexcept {
         auto w = m_windowManagement->activeWindow();
-        if (!w || (w && (!m_ignoredWindows.contains(w->internalId()))) ) {
+        if (!w || (w && (!isIgnored(w->internalId()))) ) {
             emit activeWindowChanged(w ? w->internalId() : 0);
         }
 
@@ -223,9 +231,7 @@ KWayland::Client::PlasmaShell *WaylandInterface::waylandCoronaInterface() const
 //! Register Latte Ignored Windows in order to NOT be tracked
 void WaylandInterface::registerIgnoredWindow(WindowId wid)
 {
-    if (!wid.isNull() && !m_ignoredWindows.contains(wid)) {
-        m_ignoredWindows.append(wid);
-
+    if (addRegistration(wid, IgnoredRegistration)) {
         KWayland::Client::PlasmaWindow *w = windowFor(wid);
 
         if (w) {
@@ -238,8 +244,7 @@ void WaylandInterface::registerIgnoredWindow(WindowId wid)
 
 void WaylandInterface::unregisterIgnoredWindow(WindowId wid)
 {
-    if (m_ignoredWindows.contains(wid)) {
-        m_ignoredWindows.removeAll(wid);
+    if (removeRegistration(wid, IgnoredRegistration)) {
         emit windowRemoved(wid);
     }
 }
@@ -490,42 +495,11 @@ WindowInfoWrap WaylandInterface::requestInfo(WindowId wid)
     bool plasmaBlockedWindow = w && (w->appId() == QLatin1String("org.kde.plasmashell")) && !isAcceptableWindow(w);
 
     if (w && isValidWindow(w) && !plasmaBlockedWindow) {
+        //! tracked windows keep their information updated from their change signals
+        auto info = m_windowInfos.constFind(w->internalId());
+        winfoWrap = (info != m_windowInfos.constEnd()) ? info.value() : windowInfoFor(w);
         winfoWrap.setIsValid(true);
         winfoWrap.setWid(wid);
-        winfoWrap.setParentId(w->parentWindow() ? w->parentWindow()->internalId() : 0);
-        winfoWrap.setIsActive(w->isActive());
-        winfoWrap.setIsMinimized(w->isMinimized());
-        winfoWrap.setIsMaxVert(w->isMaximized());
-        winfoWrap.setIsMaxHoriz(w->isMaximized());
-        winfoWrap.setIsFullscreen(w->isFullscreen());
-        winfoWrap.setIsShaded(w->isShaded());
-        winfoWrap.setIsOnAllDesktops(w->isOnAllDesktops());
-        winfoWrap.setIsOnAllActivities(true);
-        winfoWrap.setIsKeepAbove(w->isKeepAbove());
-        winfoWrap.setIsKeepBelow(w->isKeepBelow());
-        winfoWrap.setGeometry(w->geometry());
-
-#if KF5_VERSION_MINOR >= 47
-        winfoWrap.setHasSkipSwitcher(w->skipSwitcher());
-#endif
-        winfoWrap.setHasSkipTaskbar(w->skipTaskbar());
-
-        //! BEGIN:Window Abilities
-        winfoWrap.setIsClosable(w->isCloseable());
-        winfoWrap.setIsFullScreenable(w->isFullscreenable());
-        winfoWrap.setIsMaximizable(w->isMaximizeable());
-        winfoWrap.setIsMinimizable(w->isMinimizeable());
-        winfoWrap.setIsMovable(w->isMovable());
-        winfoWrap.setIsResizable(w->isResizable());
-        winfoWrap.setIsShadeable(w->isShadeable());
-        winfoWrap.setIsVirtualDesktopsChangeable(w->isVirtualDesktopChangeable());
-        //! END:Window Abilities
-
-        winfoWrap.setDisplay(w->title());
-#if KF5_VERSION_MINOR >= 52
-        winfoWrap.setDesktops(w->plasmaVirtualDesktops());
-#endif
-        winfoWrap.setActivities(QStringList());
     } else {
         winfoWrap.setIsValid(false);
     }
@@ -542,8 +516,9 @@ AppData WaylandInterface::appDataFor(WindowId wid)
     auto window = windowFor(wid);
 
     if (window) {
-        const AppData &data = appDataFromUrl(windowUrlFromMetadata(window->appId(),
-                                                                   window->pid(), rulesConfig));
+        bool pending{false};
+        AppData data = appDataFromUrl(AppIdentityCache::self()->windowUrl(wid, window->appId(), window->pid(), QString(), &pending));
+        data.pending = pending;
 
         return data;
     }
@@ -553,17 +528,95 @@ AppData WaylandInterface::appDataFor(WindowId wid)
     return empty;
 }
 
+WindowInfoWrap WaylandInterface::windowInfoFor(const KWayland::Client::PlasmaWindow *w) const
+{
+    WindowInfoWrap winfoWrap;
+
+    winfoWrap.setWid(w->internalId());
+    winfoWrap.setIsOnAllActivities(true);
+    winfoWrap.setActivities(QStringList());
+
+    updateInfo(winfoWrap, w, AllWindowProperties);
+
+    return winfoWrap;
+}
+
+void WaylandInterface::updateInfo(WindowInfoWrap &winfo, const KWayland::Client::PlasmaWindow *w, const WindowProperties &properties) const
+{
+    if (properties & GeometryWindowProperty) {
+        winfo.setGeometry(w->geometry());
+    }
+
+    if (properties & StateWindowProperty) {
+        winfo.setIsMinimized(w->isMinimized());
+        winfo.setIsMaxVert(w->isMaximized());
+        winfo.setIsMaxHoriz(w->isMaximized());
+        winfo.setIsFullscreen(w->isFullscreen());
+        winfo.setIsShaded(w->isShaded());
+        winfo.setIsKeepAbove(w->isKeepAbove());
+        winfo.setIsKeepBelow(w->isKeepBelow());
+
+#if KF5_VERSION_MINOR >= 47
+        winfo.setHasSkipSwitcher(w->skipSwitcher());
+#endif
+        winfo.setHasSkipTaskbar(w->skipTaskbar());
+
+        //! BEGIN:Window Abilities
+        winfo.setIsClosable(w->isCloseable());
+        winfo.setIsFullScreenable(w->isFullscreenable());
+        winfo.setIsMaximizable(w->isMaximizeable());
+        winfo.setIsMinimizable(w->isMinimizeable());
+        winfo.setIsMovable(w->isMovable());
+        winfo.setIsResizable(w->isResizable());
+        winfo.setIsShadeable(w->isShadeable());
+        winfo.setIsVirtualDesktopsChangeable(w->isVirtualDesktopChangeable());
+        //! END:Window Abilities
+    }
+
+    if (properties & ActiveWindowProperty) {
+        winfo.setIsActive(w->isActive());
+    }
+
+    if (properties & NameWindowProperty) {
+        winfo.setDisplay(w->title());
+    }
+
+    if (properties & DesktopWindowProperty) {
+        winfo.setIsOnAllDesktops(w->isOnAllDesktops());
+#if KF5_VERSION_MINOR >= 52
+        winfo.setDesktops(w->plasmaVirtualDesktops());
+#endif
+    }
+
+    if (properties & TransientWindowProperty) {
+        winfo.setParentId(w->parentWindow() ? w->parentWindow()->internalId() : 0);
+    }
+}
+
 KWayland::Client::PlasmaWindow *WaylandInterface::windowFor(WindowId wid)
 {
-    auto it = std::find_if(m_windowManagement->windows().constBegin(), m_windowManagement->windows().constEnd(), [&wid](PlasmaWindow * w) noexcept {
-            return w->isValid() && w->internalId() == wid;
-});
+    auto it = m_windows.constFind(wid.toUInt());
 
-    if (it == m_windowManagement->windows().constEnd()) {
+    if (it == m_windows.constEnd() || !it.value() || !it.value()->isValid()) {
         return nullptr;
     }
 
-    return *it;
+    return it.value();
+}
+
+void WaylandInterface::indexWindow(KWayland::Client::PlasmaWindow *w)
+{
+    if (!w || m_windows.contains(w->internalId())) {
+        return;
+    }
+
+    m_windows[w->internalId()] = w;
+
+    //! all windows are indexed, even the ones that are not tracked, e.g. latte own windows
+    connect(w, &PlasmaWindow::unmapped, this, [this, w]() {
+        m_windows.remove(w->internalId());
+        m_windowInfos.remove(w->internalId());
+    });
 }
 
 QIcon WaylandInterface::iconFor(WindowId wid)
@@ -846,13 +899,52 @@ bool WaylandInterface::isAcceptableWindow(const KWayland::Client::PlasmaWindow *
     return !isSkipped;
 }
 
-void WaylandInterface::updateWindow()
+void WaylandInterface::updateWindow(KWayland::Client::PlasmaWindow *w, const WindowProperties &properties)
 {
-    PlasmaWindow *pW = qobject_cast<PlasmaWindow*>(QObject::sender());
+    if (!isValidWindow(w)) {
+        return;
+    }
+
+    auto info = m_windowInfos.find(w->internalId());
 
-    if (isValidWindow(pW)) {
-        considerWindowChanged(pW->internalId());
+    if (info == m_windowInfos.end()) {
+        m_windowInfos[w->internalId()] = windowInfoFor(w);
+        considerWindowChanged(w->internalId());
+        return;
     }
+
+    updateInfo(info.value(), w, properties);
+    considerWindowChanged(w->internalId(), properties);
+}
+
+void WaylandInterface::updateWindowGeometry()
+{
+    updateWindow(qobject_cast<PlasmaWindow*>(QObject::sender()), GeometryWindowProperty);
+}
+
+void WaylandInterface::updateWindowState()
+{
+    updateWindow(qobject_cast<PlasmaWindow*>(QObject::sender()), StateWindowProperty);
+}
+
+void WaylandInterface::updateWindowActive()
+{
+    updateWindow(qobject_cast<PlasmaWindow*>(QObject::sender()), ActiveWindowProperty);
+}
+
+void WaylandInterface::updateWindowName()
+{
+    updateWindow(qobject_cast<PlasmaWindow*>(QObject::sender()), NameWindowProperty);
+}
+
+void WaylandInterface::updateWindowDesktops()
+{
+    updateWindow(qobject_cast<PlasmaWindow*>(QObject::sender()), DesktopWindowProperty);
+}
+
+void WaylandInterface::updateWindowParent()
+{
+    updateWindow(qobject_cast<PlasmaWindow*>(QObject::sender()), TransientWindowProperty);
 }
 
 void WaylandInterface::windowUnmapped()
@@ -871,25 +963,41 @@ void WaylandInterface::trackWindow(KWayland::Client::PlasmaWindow *w)
         return;
     }
 
-    connect(w, &PlasmaWindow::activeChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::titleChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::fullscreenChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::geometryChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::maximizedChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::minimizedChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::shadedChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::skipTaskbarChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::onAllDesktopsChanged, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::parentWindowChanged, this, &WaylandInterface::updateWindow);
+    connect(w, &PlasmaWindow::activeChanged, this, &WaylandInterface::updateWindowActive);
+    connect(w, &PlasmaWindow::titleChanged, this, &WaylandInterface::updateWindowName);
+    connect(w, &PlasmaWindow::geometryChanged, this, &WaylandInterface::updateWindowGeometry);
+    connect(w, &PlasmaWindow::fullscreenChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::maximizedChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::minimizedChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::shadedChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::keepAboveChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::keepBelowChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::skipTaskbarChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::closeableChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::fullscreenableChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::maximizeableChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::minimizeableChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::movableChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::resizableChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::shadeableChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::virtualDesktopChangeableChanged, this, &WaylandInterface::updateWindowState);
+    connect(w, &PlasmaWindow::onAllDesktopsChanged, this, &WaylandInterface::updateWindowDesktops);
+    connect(w, &PlasmaWindow::parentWindowChanged, this, &WaylandInterface::updateWindowParent);
+
+#if KF5_VERSION_MINOR >= 47
+    connect(w, &PlasmaWindow::skipSwitcherChanged, this, &WaylandInterface::updateWindowState);
+#endif
 
 #if KF5_VERSION_MINOR >= 52
-    connect(w, &PlasmaWindow::plasmaVirtualDesktopEntered, this, &WaylandInterface::updateWindow);
-    connect(w, &PlasmaWindow::plasmaVirtualDesktopLeft, this, &WaylandInterface::updateWindow);
+    connect(w, &PlasmaWindow::plasmaVirtualDesktopEntered, this, &WaylandInterface::updateWindowDesktops);
+    connect(w, &PlasmaWindow::plasmaVirtualDesktopLeft, this, &WaylandInterface::updateWindowDesktops);
 #else
-    connect(w, &PlasmaWindow::virtualDesktopChanged, this, &WaylandInterface::updateWindow);
+    connect(w, &PlasmaWindow::virtualDesktopChanged, this, &WaylandInterface::updateWindowDesktops);
 #endif
 
     connect(w, &PlasmaWindow::unmapped, this, &WaylandInterface::windowUnmapped);
+
+    m_windowInfos[w->internalId()] = windowInfoFor(w);
 }
 
 void WaylandInterface::untrackWindow(KWayland::Client::PlasmaWindow *w)
@@ -898,30 +1006,48 @@ void WaylandInterface::untrackWindow(KWayland::Client::PlasmaWindow *w)
         return;
     }
 
-    disconnect(w, &PlasmaWindow::activeChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::titleChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::fullscreenChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::geometryChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::maximizedChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::minimizedChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::shadedChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::skipTaskbarChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::onAllDesktopsChanged, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::parentWindowChanged, this, &WaylandInterface::updateWindow);
+    disconnect(w, &PlasmaWindow::activeChanged, this, &WaylandInterface::updateWindowActive);
+    disconnect(w, &PlasmaWindow::titleChanged, this, &WaylandInterface::updateWindowName);
+    disconnect(w, &PlasmaWindow::geometryChanged, this, &WaylandInterface::updateWindowGeometry);
+    disconnect(w, &PlasmaWindow::fullscreenChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::maximizedChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::minimizedChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::shadedChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::keepAboveChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::keepBelowChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::skipTaskbarChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::closeableChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::fullscreenableChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::maximizeableChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::minimizeableChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::movableChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::resizableChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::shadeableChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::virtualDesktopChangeableChanged, this, &WaylandInterface::updateWindowState);
+    disconnect(w, &PlasmaWindow::onAllDesktopsChanged, this, &WaylandInterface::updateWindowDesktops);
+    disconnect(w, &PlasmaWindow::parentWindowChanged, this, &WaylandInterface::updateWindowParent);
+
+#if KF5_VERSION_MINOR >= 47
+    disconnect(w, &PlasmaWindow::skipSwitcherChanged, this, &WaylandInterface::updateWindowState);
+#endif
 
 #if KF5_VERSION_MINOR >= 52
-    disconnect(w, &PlasmaWindow::plasmaVirtualDesktopEntered, this, &WaylandInterface::updateWindow);
-    disconnect(w, &PlasmaWindow::plasmaVirtualDesktopLeft, this, &WaylandInterface::updateWindow);
+    disconnect(w, &PlasmaWindow::plasmaVirtualDesktopEntered, this, &WaylandInterface::updateWindowDesktops);
+    disconnect(w, &PlasmaWindow::plasmaVirtualDesktopLeft, this, &WaylandInterface::updateWindowDesktops);
 #else
-    disconnect(w, &PlasmaWindow::virtualDesktopChanged, this, &WaylandInterface::updateWindow);
+    disconnect(w, &PlasmaWindow::virtualDesktopChanged, this, &WaylandInterface::updateWindowDesktops);
 #endif
 
     disconnect(w, &PlasmaWindow::unmapped, this, &WaylandInterface::windowUnmapped);
+
+    m_windowInfos.remove(w->internalId());
 }
 
 
 void WaylandInterface::windowCreatedProxy(KWayland::Client::PlasmaWindow *w)
 {
+    indexWindow(w);
+
     if (!isAcceptableWindow(w))  {
         return;
     }
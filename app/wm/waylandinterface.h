@@ -27,8 +27,10 @@
 #include "windowinfowrap.h"
 
 // Qt
+#include <QHash>
 #include <QMap>
 #include <QObject>
+#include <QPointer>
 
 // KDE
 #include <KWayland/Client/registry.h>
@@ -112,7 +114,12 @@ public:
 #endif
 
 private slots:
-    void updateWindow();
+    void updateWindowGeometry();
+    void updateWindowState();
+    void updateWindowActive();
+    void updateWindowName();
+    void updateWindowDesktops();
+    void updateWindowParent();
     void windowUnmapped();
 
 private:
@@ -126,7 +133,13 @@ private:
     void trackWindow(KWayland::Client::PlasmaWindow *w);
     void untrackWindow(KWayland::Client::PlasmaWindow *w);
 
+    void indexWindow(KWayland::Client::PlasmaWindow *w);
+    //! only the changed properties of the tracked window information are updated
+    void updateWindow(KWayland::Client::PlasmaWindow *w, const WindowProperties &properties);
+
     KWayland::Client::PlasmaWindow *windowFor(WindowId wid);
+    WindowInfoWrap windowInfoFor(const KWayland::Client::PlasmaWindow *w) const;
+    void updateInfo(WindowInfoWrap &winfo, const KWayland::Client::PlasmaWindow *w, const WindowProperties &properties) const;
     KWayland::Client::PlasmaShell *waylandCoronaInterface() const;
 
 #if KF5_VERSION_MINOR >= 52
@@ -141,6 +154,11 @@ private:
 
     KWayland::Client::PlasmaWindowManagement *m_windowManagement{nullptr};
 
+    //! window management windows by their internal id
+    QHash<quint32, QPointer<KWayland::Client::PlasmaWindow>> m_windows;
+    //! live information of tracked windows
+    QHash<quint32, WindowInfoWrap> m_windowInfos;
+
 #if KF5_VERSION_MINOR >= 52
     //! VirtualDesktopsSupport
     KWayland::Client::PlasmaVirtualDesktopManagement *m_virtualDesktopManagement{nullptr};
@@ -20,422 +20,359 @@
 
 #include "windowinfowrap.h"
 
+// Qt
+#include <QCoreApplication>
+#include <QThread>
 
 namespace Latte {
 namespace WindowSystem {
 
+namespace {
+//! interned strings are shared between all windows information, they are
+//! only a few e.g. virtual desktops and activities ids. They are used only
+//! from the GUI thread
+QHash<QString, quint16> s_internedIds;
+QStringList s_internedStrings;
+}
+
 WindowInfoWrap::WindowInfoWrap()
 {
 }
 
-WindowInfoWrap::WindowInfoWrap(const WindowInfoWrap &o)
-    : m_wid(o.m_wid)
-    , m_parentId(o.m_parentId)
-    , m_geometry(o.m_geometry)
-    , m_isValid(o.m_isValid)
-    , m_isActive(o.m_isActive)
-    , m_isMinimized(o.m_isMinimized)
-    , m_isMaxVert(o.m_isMaxVert)
-    , m_isMaxHoriz(o.m_isMaxHoriz)
-    , m_isFullscreen(o.m_isFullscreen)
-    , m_isShaded(o.m_isShaded)
-    , m_isKeepAbove(o.m_isKeepAbove)
-    , m_isKeepBelow(o.m_isKeepBelow)
-    , m_hasSkipPager(o.m_hasSkipPager)
-    , m_hasSkipSwitcher(o.m_hasSkipSwitcher)
-    , m_hasSkipTaskbar(o.m_hasSkipTaskbar)
-    , m_isOnAllDesktops(o.m_isOnAllDesktops)
-    , m_isOnAllActivities(o.m_isOnAllActivities)
-    , m_isClosable(o.m_isClosable)
-    , m_isFullScreenable(o.m_isFullScreenable)
-    , m_isGroupable(o.m_isGroupable)
-    , m_isMaximizable(o.m_isMaximizable)
-    , m_isMinimizable(o.m_isMinimizable)
-    , m_isMovable(o.m_isMovable)
-    , m_isResizable(o.m_isResizable)
-    , m_isShadeable(o.m_isShadeable)
-    , m_isVirtualDesktopsChangeable(o.m_isVirtualDesktopsChangeable)
-    , m_desktops(o.m_desktops)
-    , m_activities(o.m_activities)
-    , m_display(o.m_display)
-{
-}
-
-WindowInfoWrap::WindowInfoWrap(WindowInfoWrap &&o)
-    : m_wid(o.m_wid)
-    , m_parentId(o.m_parentId)
-    , m_geometry(o.m_geometry)
-    , m_isValid(o.m_isValid)
-    , m_isActive(o.m_isActive)
-    , m_isMinimized(o.m_isMinimized)
-    , m_isMaxVert(o.m_isMaxVert)
-    , m_isMaxHoriz(o.m_isMaxHoriz)
-    , m_isFullscreen(o.m_isFullscreen)
-    , m_isShaded(o.m_isShaded)
-    , m_isKeepAbove(o.m_isKeepAbove)
-    , m_isKeepBelow(o.m_isKeepBelow)
-    , m_hasSkipPager(o.m_hasSkipPager)
-    , m_hasSkipSwitcher(o.m_hasSkipSwitcher)
-    , m_hasSkipTaskbar(o.m_hasSkipTaskbar)
-    , m_isOnAllDesktops(o.m_isOnAllDesktops)
-    , m_isOnAllActivities(o.m_isOnAllActivities)
-    , m_isClosable(o.m_isClosable)
-    , m_isFullScreenable(o.m_isFullScreenable)
-    , m_isGroupable(o.m_isGroupable)
-    , m_isMaximizable(o.m_isMaximizable)
-    , m_isMinimizable(o.m_isMinimizable)
-    , m_isMovable(o.m_isMovable)
-    , m_isResizable(o.m_isResizable)
-    , m_isShadeable(o.m_isShadeable)
-    , m_isVirtualDesktopsChangeable(o.m_isVirtualDesktopsChangeable)
-    , m_desktops(o.m_desktops)
-    , m_activities(o.m_activities)
-    , m_display(o.m_display)
-{
-}
-
-//! Operators
-// BEGIN: definitions
-WindowInfoWrap &WindowInfoWrap::operator=(WindowInfoWrap &&rhs)
-{
-    m_wid = rhs.m_wid;
-    m_parentId = rhs.m_parentId;
-    m_geometry = rhs.m_geometry;
-    m_isValid = rhs.m_isValid;
-    m_isActive = rhs.m_isActive;
-    m_isMinimized = rhs.m_isMinimized;
-    m_isMaxVert = rhs.m_isMaxVert;
-    m_isMaxHoriz = rhs.m_isMaxHoriz;
-    m_isFullscreen = rhs.m_isFullscreen;
-    m_isShaded = rhs.m_isShaded;
-    m_isKeepAbove = rhs.m_isKeepAbove;
-    m_isKeepBelow = rhs.m_isKeepBelow;
-    m_hasSkipPager = rhs.m_hasSkipPager;
-    m_hasSkipSwitcher = rhs.m_hasSkipSwitcher;
-    m_hasSkipTaskbar = rhs.m_hasSkipTaskbar;
-    m_isOnAllDesktops = rhs.m_isOnAllDesktops;
-    m_isOnAllActivities = rhs.m_isOnAllActivities;
-    m_isClosable = rhs.m_isClosable;
-    m_isFullScreenable = rhs.m_isFullScreenable;
-    m_isGroupable = rhs.m_isGroupable;
-    m_isMaximizable = rhs.m_isMaximizable;
-    m_isMinimizable = rhs.m_isMinimizable;
-    m_isMovable = rhs.m_isMovable;
-    m_isResizable = rhs.m_isResizable;
-    m_isShadeable = rhs.m_isShadeable;
-    m_isVirtualDesktopsChangeable = rhs.m_isVirtualDesktopsChangeable;
-
-    m_display = rhs.m_display;
-    m_desktops = rhs.m_desktops;
-    m_activities = rhs.m_activities;
-    return *this;
-}
-
-WindowInfoWrap &WindowInfoWrap::operator=(const WindowInfoWrap &rhs)
-{
-    m_wid = rhs.m_wid;
-    m_parentId = rhs.m_parentId;
-    m_geometry = rhs.m_geometry;
-    m_isValid = rhs.m_isValid;
-    m_isActive = rhs.m_isActive;
-    m_isMinimized = rhs.m_isMinimized;
-    m_isMaxVert = rhs.m_isMaxVert;
-    m_isMaxHoriz = rhs.m_isMaxHoriz;
-    m_isFullscreen = rhs.m_isFullscreen;
-    m_isShaded = rhs.m_isShaded;
-    m_isKeepAbove = rhs.m_isKeepAbove;
-    m_isKeepBelow = rhs.m_isKeepBelow;
-    m_hasSkipPager = rhs.m_hasSkipPager;
-    m_hasSkipSwitcher = rhs.m_hasSkipSwitcher;
-    m_hasSkipTaskbar = rhs.m_hasSkipTaskbar;
-    m_isOnAllDesktops = rhs.m_isOnAllDesktops;
-    m_isOnAllActivities = rhs.m_isOnAllActivities;
-    m_isClosable = rhs.m_isClosable;
-    m_isFullScreenable = rhs.m_isFullScreenable;
-    m_isGroupable = rhs.m_isGroupable;
-    m_isMaximizable = rhs.m_isMaximizable;
-    m_isMinimizable = rhs.m_isMinimizable;
-    m_isMovable = rhs.m_isMovable;
-    m_isResizable = rhs.m_isResizable;
-    m_isShadeable = rhs.m_isShadeable;
-    m_isVirtualDesktopsChangeable = rhs.m_isVirtualDesktopsChangeable;
-
-    m_display = rhs.m_display;
-    m_desktops = rhs.m_desktops;
-    m_activities = rhs.m_activities;
-    return *this;
+WindowInfoWrap::ExtraData *WindowInfoWrap::extra()
+{
+    if (!m_extra) {
+        m_extra = new ExtraData;
+    }
+
+    return m_extra.data();
+}
+
+quint16 WindowInfoWrap::internedId(const QString &str)
+{
+    Q_ASSERT(!qApp || QThread::currentThread() == qApp->thread());
+
+    auto it = s_internedIds.constFind(str);
+
+    if (it != s_internedIds.constEnd()) {
+        return it.value();
+    }
+
+    quint16 id = s_internedStrings.count();
+    s_internedStrings << str;
+    s_internedIds[str] = id;
+
+    return id;
+}
+
+QString WindowInfoWrap::internedString(quint16 id)
+{
+    return s_internedStrings.value(id);
+}
+
+bool WindowInfoWrap::hasFlag(StateFlag flag) const
+{
+    return (m_flags & flag);
+}
+
+void WindowInfoWrap::setFlag(StateFlag flag, bool on)
+{
+    if (on) {
+        m_flags |= flag;
+    } else {
+        m_flags &= ~flag;
+    }
 }
 
 //! Access properties
 bool WindowInfoWrap::isValid() const
 {
-    return m_isValid;
+    return hasFlag(IsValid);
 }
 
 void WindowInfoWrap::setIsValid(bool isValid)
 {
-    m_isValid = isValid;
+    setFlag(IsValid, isValid);
 }
 
 bool WindowInfoWrap::isActive() const
 {
-    return m_isActive;
+    return hasFlag(IsActive);
 }
 
 void WindowInfoWrap::setIsActive(bool isActive)
 {
-    m_isActive = isActive;
+    setFlag(IsActive, isActive);
 }
 
 bool WindowInfoWrap::isMinimized() const
 {
-    return m_isMinimized;
+    return hasFlag(IsMinimized);
 }
 
 void WindowInfoWrap::setIsMinimized(bool isMinimized)
 {
-    m_isMinimized = isMinimized;
+    setFlag(IsMinimized, isMinimized);
 }
 
 bool WindowInfoWrap::isMaximized() const
 {
-    return m_isMaxVert && m_isMaxHoriz;
+    return hasFlag(IsMaxVert) && hasFlag(IsMaxHoriz);
 }
 
 bool WindowInfoWrap::isMaxVert() const
 {
-    return m_isMaxVert;
+    return hasFlag(IsMaxVert);
 }
 
 void WindowInfoWrap::setIsMaxVert(bool isMaxVert)
 {
-    m_isMaxVert = isMaxVert;
+    setFlag(IsMaxVert, isMaxVert);
 }
 
 bool WindowInfoWrap::isMaxHoriz() const
 {
-    return m_isMaxHoriz;
+    return hasFlag(IsMaxHoriz);
 }
 
 void WindowInfoWrap::setIsMaxHoriz(bool isMaxHoriz)
 {
-    m_isMaxHoriz = isMaxHoriz;
+    setFlag(IsMaxHoriz, isMaxHoriz);
 }
 
 bool WindowInfoWrap::isFullscreen() const
 {
-    return m_isFullscreen;
+    return hasFlag(IsFullscreen);
 }
 
 void WindowInfoWrap::setIsFullscreen(bool isFullscreen)
 {
-    m_isFullscreen = isFullscreen;
+    setFlag(IsFullscreen, isFullscreen);
 }
 
 bool WindowInfoWrap::isShaded() const
 {
-    return m_isShaded;
+    return hasFlag(IsShaded);
 }
 
 void WindowInfoWrap::setIsShaded(bool isShaded)
 {
-    m_isShaded = isShaded;
+    setFlag(IsShaded, isShaded);
 }
 
 bool WindowInfoWrap::isKeepAbove() const
 {
-    return m_isKeepAbove;
+    return hasFlag(IsKeepAbove);
 }
 
 void WindowInfoWrap::setIsKeepAbove(bool isKeepAbove)
 {
-    m_isKeepAbove = isKeepAbove;
+    setFlag(IsKeepAbove, isKeepAbove);
 }
 
 bool WindowInfoWrap::isKeepBelow() const
 {
-    return m_isKeepBelow;
+    return hasFlag(IsKeepBelow);
 }
 
 void WindowInfoWrap::setIsKeepBelow(bool isKeepBelow)
 {
-    m_isKeepBelow = isKeepBelow;
+    setFlag(IsKeepBelow, isKeepBelow);
 }
 
 bool WindowInfoWrap::hasSkipPager() const
 {
-    return m_hasSkipPager;
+    return hasFlag(HasSkipPager);
 }
 
 void WindowInfoWrap::setHasSkipPager(bool skipPager)
 {
-    m_hasSkipPager = skipPager;
+    setFlag(HasSkipPager, skipPager);
 }
 
 bool WindowInfoWrap::hasSkipSwitcher() const
 {
-    return m_hasSkipSwitcher;
+    return hasFlag(HasSkipSwitcher);
 }
 
 void WindowInfoWrap::setHasSkipSwitcher(bool skipSwitcher)
 {
-    m_hasSkipSwitcher = skipSwitcher;
+    setFlag(HasSkipSwitcher, skipSwitcher);
 }
 
 bool WindowInfoWrap::hasSkipTaskbar() const
 {
-    return m_hasSkipTaskbar;
+    return hasFlag(HasSkipTaskbar);
 }
 
 void WindowInfoWrap::setHasSkipTaskbar(bool skipTaskbar)
 {
-    m_hasSkipTaskbar = skipTaskbar;
+    setFlag(HasSkipTaskbar, skipTaskbar);
 }
 
 bool WindowInfoWrap::isOnAllDesktops() const
 {
-    return m_isOnAllDesktops;
+    return hasFlag(IsOnAllDesktops);
 }
 
 void WindowInfoWrap::setIsOnAllDesktops(bool alldesktops)
 {
-    m_isOnAllDesktops = alldesktops;
+    setFlag(IsOnAllDesktops, alldesktops);
 }
 
 bool WindowInfoWrap::isOnAllActivities() const
 {
-    return m_isOnAllActivities;
+    return hasFlag(IsOnAllActivities);
 }
 
 void WindowInfoWrap::setIsOnAllActivities(bool allactivities)
 {
-    m_isOnAllActivities = allactivities;
+    setFlag(IsOnAllActivities, allactivities);
 }
 
 //!BEGIN: Window Abilities
 bool WindowInfoWrap::isCloseable() const
 {
-    return m_isClosable;
+    return hasFlag(IsClosable);
 }
+
 void WindowInfoWrap::setIsClosable(bool closable)
 {
-    m_isClosable = closable;
+    setFlag(IsClosable, closable);
 }
 
 bool WindowInfoWrap::isFullScreenable() const
 {
-    return m_isFullScreenable;
+    return hasFlag(IsFullScreenable);
 }
+
 void WindowInfoWrap::setIsFullScreenable(bool fullscreenable)
 {
-    m_isFullScreenable = fullscreenable;
+    setFlag(IsFullScreenable, fullscreenable);
 }
 
 bool WindowInfoWrap::isGroupable() const
 {
-    return m_isGroupable;
+    return hasFlag(IsGroupable);
 }
+
 void WindowInfoWrap::setIsGroupable(bool groupable)
 {
-    m_isGroupable = groupable;
+    setFlag(IsGroupable, groupable);
 }
 
 bool WindowInfoWrap::isMaximizable() const
 {
-    return m_isMaximizable;
+    return hasFlag(IsMaximizable);
 }
+
 void WindowInfoWrap::setIsMaximizable(bool maximizable)
 {
-    m_isMaximizable = maximizable;
+    setFlag(IsMaximizable, maximizable);
 }
 
 bool WindowInfoWrap::isMinimizable() const
 {
-    return m_isMinimizable;
+    return hasFlag(IsMinimizable);
 }
+
 void WindowInfoWrap::setIsMinimizable(bool minimizable)
 {
-    m_isMinimizable = minimizable;
+    setFlag(IsMinimizable, minimizable);
 }
 
 bool WindowInfoWrap::isMovable() const
 {
-    return m_isMovable;
+    return hasFlag(IsMovable);
 }
+
 void WindowInfoWrap::setIsMovable(bool movable)
 {
-    m_isMovable = movable;
+    setFlag(IsMovable, movable);
 }
 
 bool WindowInfoWrap::isResizable() const
 {
-    return m_isResizable;
+    return hasFlag(IsResizable);
 }
+
 void WindowInfoWrap::setIsResizable(bool resizable)
 {
-    m_isResizable = resizable;
+    setFlag(IsResizable, resizable);
 }
 
 bool WindowInfoWrap::isShadeable() const
 {
-    return m_isShadeable;
+    return hasFlag(IsShadeable);
 }
+
 void WindowInfoWrap::setIsShadeable(bool shadeble)
 {
-    m_isShadeable = shadeble;
+    setFlag(IsShadeable, shadeble);
 }
 
 bool WindowInfoWrap::isVirtualDesktopsChangeable() const
 {
-    return m_isVirtualDesktopsChangeable;
+    return hasFlag(IsVirtualDesktopsChangeable);
 }
+
 void WindowInfoWrap::setIsVirtualDesktopsChangeable(bool virtualdesktopchangeable)
 {
-    m_isVirtualDesktopsChangeable = virtualdesktopchangeable;
+    setFlag(IsVirtualDesktopsChangeable, virtualdesktopchangeable);
 }
 //!END: Window Abilities
 
-
-
 bool WindowInfoWrap::isMainWindow() const
 {
-    return (m_parentId.toInt() <= 0);
+    return m_parentId.isNull();
 }
 
 bool WindowInfoWrap::isChildWindow() const
 {
-    return (m_parentId.toInt() > 0);
+    return !m_parentId.isNull();
 }
 
 
 QString WindowInfoWrap::appName() const
 {
-    return m_appName;
+    return m_extra ? m_extra->appName : QString();
 }
 
 void WindowInfoWrap::setAppName(const QString &appName)
 {
-    m_appName = appName;
+    if (this->appName() == appName) {
+        return;
+    }
+
+    extra()->appName = appName;
 }
 
 QString WindowInfoWrap::display() const
 {
-    return m_display;
+    return m_extra ? m_extra->display : QString();
 }
 
 void WindowInfoWrap::setDisplay(const QString &display)
 {
-    m_display = display;
+    if (this->display() == display) {
+        return;
+    }
+
+    extra()->display = display;
 }
 
 QIcon WindowInfoWrap::icon() const
 {
-    return m_icon;
+    return m_extra ? m_extra->icon : QIcon();
 }
 
 void WindowInfoWrap::setIcon(const QIcon &icon)
 {
-    m_icon = icon;
+    if (!m_extra && icon.isNull()) {
+        return;
+    }
+
+    extra()->icon = icon;
 }
 
 QRect WindowInfoWrap::geometry() const
@@ -450,7 +387,7 @@ void WindowInfoWrap::setGeometry(const QRect &geometry)
 
 WindowId WindowInfoWrap::wid() const
 {
-    return m_wid;
+    return m_wid.toWindowId();
 }
 
 void WindowInfoWrap::setWid(const WindowId &wid)
@@ -458,14 +395,19 @@ void WindowInfoWrap::setWid(const WindowId &wid)
     m_wid = wid;
 }
 
+WindowKey WindowInfoWrap::key() const
+{
+    return m_wid;
+}
+
 WindowId WindowInfoWrap::parentId() const
 {
-    return m_parentId;
+    return m_parentId.toWindowId();
 }
 
 void WindowInfoWrap::setParentId(const WindowId &parentId)
 {
-    if (m_wid == parentId) {
+    if (m_wid == WindowKey(parentId)) {
         return;
     }
 
@@ -474,32 +416,127 @@ void WindowInfoWrap::setParentId(const WindowId &parentId)
 
 QStringList WindowInfoWrap::desktops() const
 {
-    return m_desktops;
+    QStringList desktops;
+
+    for (const auto id : m_desktops) {
+        desktops << internedString(id);
+    }
+
+    return desktops;
 }
 
 void WindowInfoWrap::setDesktops(const QStringList &desktops)
 {
-    m_desktops = desktops;
+    m_desktops.clear();
+
+    for (const auto &desktop : desktops) {
+        m_desktops << internedId(desktop);
+    }
 }
 
 QStringList WindowInfoWrap::activities() const
 {
-    return m_activities;
+    QStringList activities;
+
+    for (const auto id : m_activities) {
+        activities << internedString(id);
+    }
+
+    return activities;
 }
 
 void WindowInfoWrap::setActivities(const QStringList &activities)
 {
-    m_activities = activities;
+    m_activities.clear();
+
+    for (const auto &activity : activities) {
+        m_activities << internedId(activity);
+    }
 }
 
 bool WindowInfoWrap::isOnDesktop(const QString &desktop) const
 {
-    return m_isOnAllDesktops || m_desktops.contains(desktop);
+    return hasFlag(IsOnAllDesktops) || m_desktops.contains(internedId(desktop));
 }
 
 bool WindowInfoWrap::isOnActivity(const QString &activity) const
 {
-    return m_isOnAllActivities || m_activities.contains(activity);
+    return hasFlag(IsOnAllActivities) || m_activities.contains(internedId(activity));
+}
+
+void WindowInfoWrap::updateProperties(const WindowInfoWrap &info, const WindowProperties &properties)
+{
+    if (properties == AllWindowProperties) {
+        *this = info;
+        return;
+    }
+
+    m_wid = info.m_wid;
+    setFlag(IsValid, info.hasFlag(IsValid));
+
+    if (properties & GeometryWindowProperty) {
+        m_geometry = info.m_geometry;
+    }
+
+    if (properties & StateWindowProperty) {
+        //! window abilities follow the window state
+        const quint32 mask = StateFlags | AbilityFlags;
+        m_flags = (m_flags & ~mask) | (info.m_flags & mask);
+    }
+
+    if (properties & ActiveWindowProperty) {
+        setFlag(IsActive, info.hasFlag(IsActive));
+    }
+
+    if (properties & NameWindowProperty) {
+        setDisplay(info.display());
+    }
+
+    if (properties & DesktopWindowProperty) {
+        setFlag(IsOnAllDesktops, info.hasFlag(IsOnAllDesktops));
+        m_desktops = info.m_desktops;
+    }
+
+    if (properties & ActivitiesWindowProperty) {
+        setFlag(IsOnAllActivities, info.hasFlag(IsOnAllActivities));
+        m_activities = info.m_activities;
+    }
+
+    if (properties & TransientWindowProperty) {
+        m_parentId = info.m_parentId;
+    }
+}
+
+QDataStream &operator<<(QDataStream &out, const WindowInfoWrap &winfo)
+{
+    out << winfo.m_wid.value() << winfo.m_parentId.value() << winfo.m_geometry << winfo.m_flags
+        << winfo.desktops() << winfo.activities() << winfo.appName();
+
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, WindowInfoWrap &winfo)
+{
+    quint64 wid;
+    quint64 parentId;
+    QRect geometry;
+    quint32 flags;
+    QStringList desktops;
+    QStringList activities;
+    QString appName;
+
+    in >> wid >> parentId >> geometry >> flags >> desktops >> activities >> appName;
+
+    winfo = WindowInfoWrap();
+    winfo.m_wid = WindowKey(wid);
+    winfo.m_parentId = WindowKey(parentId);
+    winfo.m_geometry = geometry;
+    winfo.m_flags = flags;
+    winfo.setDesktops(desktops);
+    winfo.setActivities(activities);
+    winfo.setAppName(appName);
+
+    return in;
 }
 
 }
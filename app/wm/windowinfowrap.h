@@ -23,25 +23,67 @@
 
 // Qt
 #include <QWindow>
+#include <QDataStream>
+#include <QHash>
 #include <QIcon>
 #include <QRect>
+#include <QSharedData>
+#include <QSharedDataPointer>
 #include <QVariant>
+#include <QVector>
 
 namespace Latte {
 namespace WindowSystem {
 
 using WindowId = QVariant;
 
+//! strongly typed integer window id, X11 window ids and Wayland internal ids are both integers
+//! and as such they are used as cheap lookup keys instead of comparing QVariants
+class WindowKey
+{
+public:
+    WindowKey() = default;
+    WindowKey(const WindowId &wid) : m_value(wid.toULongLong()) {}
+    explicit WindowKey(quint64 value) : m_value(value) {}
+
+    quint64 value() const { return m_value; }
+    bool isNull() const { return m_value == 0; }
+
+    WindowId toWindowId() const { return WindowId(m_value); }
+
+    bool operator==(const WindowKey &rhs) const { return m_value == rhs.m_value; }
+    bool operator!=(const WindowKey &rhs) const { return m_value != rhs.m_value; }
+    bool operator<(const WindowKey &rhs) const { return m_value < rhs.m_value; }
+
+private:
+    quint64 m_value{0};
+};
+
+inline uint qHash(const WindowKey &key, uint seed = 0)
+{
+    return qHash(key.value(), seed);
+}
+
+//! window information groups that can be refreshed independently
+enum WindowProperty
+{
+    NoWindowProperty = 0x00,
+    GeometryWindowProperty = 0x01,
+    StateWindowProperty = 0x02,
+    ActiveWindowProperty = 0x04,
+    NameWindowProperty = 0x08,
+    DesktopWindowProperty = 0x10,
+    ActivitiesWindowProperty = 0x20,
+    TransientWindowProperty = 0x40,
+    AllWindowProperties = 0xFF
+};
+Q_DECLARE_FLAGS(WindowProperties, WindowProperty)
+
 class WindowInfoWrap
 {
 
 public:
     WindowInfoWrap();
-    WindowInfoWrap(const WindowInfoWrap &o);
-    WindowInfoWrap(WindowInfoWrap &&o);
-
-    WindowInfoWrap &operator=(WindowInfoWrap &&rhs);
-    WindowInfoWrap &operator=(const WindowInfoWrap &rhs);
 
     bool isValid() const;
     void setIsValid(bool isValid);
@@ -134,6 +176,8 @@ public:
     WindowId wid() const;
     void setWid(const WindowId &wid);
 
+    WindowKey key() const;
+
     WindowId parentId() const;
     void setParentId(const WindowId &parentId);
 
@@ -146,49 +190,90 @@ public:
     bool isOnDesktop(const QString &desktop) const;
     bool isOnActivity(const QString &activity) const;
 
-private:
-    WindowId m_wid{0};
-    WindowId m_parentId{0};
+    //! copies only the provided properties groups from info
+    void updateProperties(const WindowInfoWrap &info, const WindowProperties &properties);
 
-    QRect m_geometry;
+private:
+    //! compact serialization that is used by window system events traces,
+    //! icons and window titles are not stored
+    friend QDataStream &operator<<(QDataStream &out, const WindowInfoWrap &winfo);
+    friend QDataStream &operator>>(QDataStream &in, WindowInfoWrap &winfo);
+
+    enum StateFlag
+    {
+        IsValid = 1 << 0,
+        IsActive = 1 << 1,
+        IsMinimized = 1 << 2,
+        IsMaxVert = 1 << 3,
+        IsMaxHoriz = 1 << 4,
+        IsFullscreen = 1 << 5,
+        IsShaded = 1 << 6,
+        IsKeepAbove = 1 << 7,
+        IsKeepBelow = 1 << 8,
+        HasSkipPager = 1 << 9,
+        HasSkipSwitcher = 1 << 10,
+        HasSkipTaskbar = 1 << 11,
+        IsOnAllDesktops = 1 << 12,
+        IsOnAllActivities = 1 << 13,
+        //!BEGIN: Window Abilities
+        IsClosable = 1 << 14,
+        IsFullScreenable = 1 << 15,
+        IsGroupable = 1 << 16,
+        IsMaximizable = 1 << 17,
+        IsMinimizable = 1 << 18,
+        IsMovable = 1 << 19,
+        IsResizable = 1 << 20,
+        IsShadeable = 1 << 21,
+        IsVirtualDesktopsChangeable = 1 << 22,
+        //!END: Window Abilities
+        StateFlags = IsMinimized | IsMaxVert | IsMaxHoriz | IsFullscreen | IsShaded | IsKeepAbove | IsKeepBelow
+                     | HasSkipPager | HasSkipSwitcher | HasSkipTaskbar,
+        AbilityFlags = IsClosable | IsFullScreenable | IsGroupable | IsMaximizable | IsMinimizable | IsMovable
+                       | IsResizable | IsShadeable | IsVirtualDesktopsChangeable
+    };
+
+    //! rarely used data are kept out of the window information that is scanned when
+    //! tracking windows, they are allocated only when they are set and they are shared
+    //! between copies until they are changed
+    class ExtraData : public QSharedData
+    {
+    public:
+        QString appName;
+        QString display;
+        QIcon icon;
+    };
+
+    bool hasFlag(StateFlag flag) const;
+    void setFlag(StateFlag flag, bool on);
+
+    ExtraData *extra();
+
+    //! the interned strings tables are not guarded, window information must be
+    //! created and queried only from the GUI thread
+    static quint16 internedId(const QString &str);
+    static QString internedString(quint16 id);
 
-    bool m_isValid{false};
-    bool m_isActive{false};
-    bool m_isMinimized{false};
-    bool m_isMaxVert{false};
-    bool m_isMaxHoriz{false};
-    bool m_isFullscreen{false};
-    bool m_isShaded{false};
-    bool m_isKeepAbove{false};
-    bool m_isKeepBelow{false};
-    bool m_hasSkipPager{false};
-    bool m_hasSkipSwitcher{false};
-    bool m_hasSkipTaskbar{false};
-    bool m_isOnAllDesktops{false};
-    bool m_isOnAllActivities{false};
+private:
+    WindowKey m_wid;
+    WindowKey m_parentId;
 
-    //!BEGIN: Window Abilities
-    bool m_isClosable{false};
-    bool m_isFullScreenable{false};
-    bool m_isGroupable{false};
-    bool m_isMaximizable{false};
-    bool m_isMinimizable{false};
-    bool m_isMovable{false};
-    bool m_isResizable{false};
-    bool m_isShadeable{false};
-    bool m_isVirtualDesktopsChangeable{false};
-    //!END: Window Abilities
+    QRect m_geometry;
 
-    QString m_appName;
-    QString m_display;
+    quint32 m_flags{0};
 
-    QIcon m_icon;
+    //! desktops and activities are interned, window information stores only their ids
+    QVector<quint16> m_desktops;
+    QVector<quint16> m_activities;
 
-    QStringList m_desktops;
-    QStringList m_activities;
+    QSharedDataPointer<ExtraData> m_extra;
 };
 
+QDataStream &operator<<(QDataStream &out, const WindowInfoWrap &winfo);
+QDataStream &operator>>(QDataStream &in, WindowInfoWrap &winfo);
+
 }
 }
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(Latte::WindowSystem::WindowProperties)
+
 #endif // WINDOWINFOWRAP_H
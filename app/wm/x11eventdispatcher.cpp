@@ -0,0 +1,169 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "x11eventdispatcher.h"
+
+// Qt
+#include <QDebug>
+#include <QGuiApplication>
+#include <QtX11Extras/QX11Info>
+
+// KDE
+#include <KWindowSystem>
+
+// X11
+#include <xcb/randr.h>
+#include <xcb/shape.h>
+#include <xcb/xcb_event.h>
+
+namespace Latte {
+namespace WindowSystem {
+
+X11EventDispatcher::X11EventDispatcher(QObject *parent)
+    : QObject(parent)
+{
+}
+
+X11EventDispatcher::~X11EventDispatcher()
+{
+    if (m_filterInstalled && qApp) {
+        qApp->removeNativeEventFilter(this);
+    }
+}
+
+X11EventDispatcher *X11EventDispatcher::self()
+{
+    static X11EventDispatcher dispatcher;
+    return &dispatcher;
+}
+
+void X11EventDispatcher::queryExtension(const Extension &extension)
+{
+    ExtensionData &data = m_extensions[extension];
+
+    if (data.queried) {
+        return;
+    }
+
+    data.queried = true;
+
+    if (!KWindowSystem::isPlatformX11()) {
+        return;
+    }
+
+    xcb_extension_t *id = (extension == RandrExtension) ? &xcb_randr_id : &xcb_shape_id;
+    const xcb_query_extension_reply_t *reply = xcb_get_extension_data(QX11Info::connection(), id);
+
+    if (reply && reply->present) {
+        data.present = true;
+        data.firstEvent = reply->first_event;
+    }
+}
+
+bool X11EventDispatcher::extensionPresent(const Extension &extension)
+{
+    queryExtension(extension);
+    return m_extensions[extension].present;
+}
+
+quint8 X11EventDispatcher::extensionFirstEvent(const Extension &extension)
+{
+    queryExtension(extension);
+    return m_extensions[extension].firstEvent;
+}
+
+void X11EventDispatcher::addHandler(quint8 responseType, QObject *receiver, Handler handler)
+{
+    if (!KWindowSystem::isPlatformX11() || !receiver || responseType >= 128) {
+        return;
+    }
+
+    if (!m_filterInstalled) {
+        qApp->installNativeEventFilter(this);
+        m_filterInstalled = true;
+    }
+
+    if (!m_receivers.contains(receiver)) {
+        m_receivers << receiver;
+        connect(receiver, &QObject::destroyed, this, &X11EventDispatcher::removeHandlers);
+    }
+
+    HandlerData data;
+    data.receiver = receiver;
+    data.handler = handler;
+
+    m_handlers[responseType] << data;
+}
+
+void X11EventDispatcher::addExtensionHandler(const Extension &extension, quint8 eventOffset, QObject *receiver, Handler handler)
+{
+    if (!extensionPresent(extension)) {
+        qDebug() << "X11 extension is not present, its events can not be handled :: " << extension;
+        return;
+    }
+
+    addHandler(extensionFirstEvent(extension) + eventOffset, receiver, handler);
+}
+
+void X11EventDispatcher::removeHandlers(QObject *receiver)
+{
+    if (!m_receivers.remove(receiver)) {
+        return;
+    }
+
+    disconnect(receiver, &QObject::destroyed, this, &X11EventDispatcher::removeHandlers);
+
+    for (auto &handlers : m_handlers) {
+        for (int i = handlers.count() - 1; i >= 0; --i) {
+            if (handlers[i].receiver == receiver) {
+                handlers.remove(i);
+            }
+        }
+    }
+}
+
+bool X11EventDispatcher::nativeEventFilter(const QByteArray &eventType, void *message, long *result)
+{
+    Q_UNUSED(result);
+
+    if (eventType != "xcb_generic_event_t") {
+        return false;
+    }
+
+    xcb_generic_event_t *event = static_cast<xcb_generic_event_t *>(message);
+
+    if (m_handlers[XCB_EVENT_RESPONSE_TYPE(event)].isEmpty()) {
+        return false;
+    }
+
+    //! handlers may be added or removed from inside a handler
+    const QVector<HandlerData> handlers = m_handlers[XCB_EVENT_RESPONSE_TYPE(event)];
+
+    for (const auto &data : handlers) {
+        if (m_receivers.contains(data.receiver)) {
+            data.handler(event);
+        }
+    }
+
+    return false;
+}
+
+}
+}
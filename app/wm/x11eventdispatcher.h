@@ -0,0 +1,106 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef X11EVENTDISPATCHER_H
+#define X11EVENTDISPATCHER_H
+
+// Qt
+#include <QAbstractNativeEventFilter>
+#include <QObject>
+#include <QSet>
+#include <QVector>
+
+// C++
+#include <functional>
+
+// X11
+#include <xcb/xcb.h>
+
+namespace Latte {
+namespace WindowSystem {
+
+//! The single native event filter of Latte under X11. Components register handlers for the
+//! event response types they are interested in and events are routed through a table that is
+//! indexed by response type, so events without handlers e.g. pointer motions cost only a lookup.
+//! Extensions data are queried once and they are cached for the rest of the session.
+class X11EventDispatcher : public QObject, public QAbstractNativeEventFilter
+{
+    Q_OBJECT
+
+public:
+    enum Extension
+    {
+        RandrExtension = 0,
+        ShapeExtension,
+        ExtensionsCount
+    };
+
+    using Handler = std::function<void(xcb_generic_event_t *event)>;
+
+    static X11EventDispatcher *self();
+    ~X11EventDispatcher() override;
+
+    bool extensionPresent(const Extension &extension);
+    //! the response type of the extension first event, it is valid only when the extension is present
+    quint8 extensionFirstEvent(const Extension &extension);
+
+    //! handlers are removed automatically when their receiver is destroyed
+    void addHandler(quint8 responseType, QObject *receiver, Handler handler);
+    //! eventOffset is relative to the extension first event, e.g. XCB_RANDR_SCREEN_CHANGE_NOTIFY
+    void addExtensionHandler(const Extension &extension, quint8 eventOffset, QObject *receiver, Handler handler);
+
+public slots:
+    void removeHandlers(QObject *receiver);
+
+protected:
+    bool nativeEventFilter(const QByteArray &eventType, void *message, long *result) override;
+
+private:
+    X11EventDispatcher(QObject *parent = nullptr);
+
+    void queryExtension(const Extension &extension);
+
+private:
+    struct HandlerData
+    {
+        QObject *receiver{nullptr};
+        Handler handler;
+    };
+
+    struct ExtensionData
+    {
+        bool queried{false};
+        bool present{false};
+        quint8 firstEvent{0};
+    };
+
+    bool m_filterInstalled{false};
+
+    ExtensionData m_extensions[ExtensionsCount];
+
+    QSet<QObject *> m_receivers;
+    //! indexed by the event response type without the synthetic event bit
+    QVector<HandlerData> m_handlers[128];
+};
+
+}
+}
+
+#endif
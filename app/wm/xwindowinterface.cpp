@@ -22,13 +22,20 @@
 
 // local
 #include <coretypes.h>
+#include "appidentitycache.h"
 #include "tasktools.h"
+#include "x11eventdispatcher.h"
 #include "view/view.h"
 #include "view/helpers/screenedgeghostwindow.h"
 
+// C++
+#include <cstring>
+
 // Qt
 #include <QDebug>
+#include <QGuiApplication>
 #include <QTimer>
+#include <QVector>
 #include <QtX11Extras/QX11Info>
 
 // KDE
@@ -45,16 +52,76 @@
 namespace Latte {
 namespace WindowSystem {
 
+const int MAXPROPERTYLENGTH = 2048;
+
+//! activities uuid used from KWin for windows that are shown on all activities
+const char ALLACTIVITIESUUID[] = "00000000-0000-0000-0000-000000000000";
+
+namespace {
+QByteArray propertyValue(xcb_connection_t *c, xcb_get_property_cookie_t cookie)
+{
+    QScopedPointer<xcb_get_property_reply_t, QScopedPointerPodDeleter> reply(xcb_get_property_reply(c, cookie, nullptr));
+
+    if (reply.isNull() || reply->type == XCB_ATOM_NONE) {
+        return QByteArray();
+    }
+
+    return QByteArray(static_cast<const char *>(xcb_get_property_value(reply.data())), xcb_get_property_value_length(reply.data()));
+}
+
+QVector<quint32> propertyValues(xcb_connection_t *c, xcb_get_property_cookie_t cookie)
+{
+    const QByteArray value = propertyValue(c, cookie);
+    QVector<quint32> values(value.size() / sizeof(quint32));
+
+    if (!values.isEmpty()) {
+        memcpy(values.data(), value.constData(), values.size() * sizeof(quint32));
+    }
+
+    return values;
+}
+
+//! extents are provided as left, right, top, bottom
+QMargins extentsMargins(const QVector<quint32> &extents)
+{
+    if (extents.size() != 4) {
+        return QMargins();
+    }
+
+    return QMargins(extents[0], extents[2], extents[1], extents[3]);
+}
+}
+
 XWindowInterface::XWindowInterface(QObject *parent)
     : AbstractWindowInterface(parent)
 {
     m_currentDesktop = QString(KWindowSystem::self()->currentDesktop());
 
+    initAtoms();
+    initInfosSentinel();
+
+    //! completed batches are delivered outside of the native events filtering
+    m_completedInfosTimer.setInterval(0);
+    m_completedInfosTimer.setSingleShot(true);
+    connect(&m_completedInfosTimer, &QTimer::timeout, this, &XWindowInterface::receiveCompletedInfos);
+
     connect(KWindowSystem::self(), &KWindowSystem::activeWindowChanged, this, &AbstractWindowInterface::activeWindowChanged);
     connect(KWindowSystem::self(), &KWindowSystem::windowRemoved, this, &AbstractWindowInterface::windowRemoved);
 
     connect(KWindowSystem::self(), &KWindowSystem::windowAdded, this, &XWindowInterface::windowAddedProxy);
 
+    connect(this, &AbstractWindowInterface::windowRemoved, this, [&](WindowId wid) {
+        m_acceptedWindows.remove(wid);
+    });
+
+    //! plasma panels and fullscreen windows are identified based on screens geometries
+    connect(qGuiApp, &QGuiApplication::screenAdded, this, [&]() {
+        m_acceptedWindows.clear();
+    });
+    connect(qGuiApp, &QGuiApplication::screenRemoved, this, [&]() {
+        m_acceptedWindows.clear();
+    });
+
     connect(KWindowSystem::self(), &KWindowSystem::currentDesktopChanged, this, [&](int desktop) {
         m_currentDesktop = QString(desktop);
         emit currentDesktopChanged();
@@ -73,6 +140,107 @@ XWindowInterface::XWindowInterface(QObject *parent)
 
 XWindowInterface::~XWindowInterface()
 {
+    m_completedInfosTimer.stop();
+
+    //! discard any pending replies in order to not leave them in the xcb connection queue
+    for (const auto &batch : m_pendingInfos) {
+        discardInfosBatch(batch);
+    }
+
+    m_pendingInfos.clear();
+
+    if (m_infosSentinelWindow != XCB_WINDOW_NONE) {
+        xcb_destroy_window(QX11Info::connection(), m_infosSentinelWindow);
+        xcb_flush(QX11Info::connection());
+    }
+}
+
+void XWindowInterface::initAtoms()
+{
+    const QList<QByteArray> names{"UTF8_STRING",
+                                  "_NET_WM_NAME",
+                                  "_NET_WM_VISIBLE_NAME",
+                                  "_NET_WM_DESKTOP",
+                                  "_NET_FRAME_EXTENTS",
+                                  "_GTK_FRAME_EXTENTS",
+                                  "_KDE_NET_WM_ACTIVITIES",
+                                  "_NET_WM_STATE",
+                                  "_NET_WM_STATE_HIDDEN",
+                                  "_NET_WM_STATE_MAXIMIZED_VERT",
+                                  "_NET_WM_STATE_MAXIMIZED_HORZ",
+                                  "_NET_WM_STATE_FULLSCREEN",
+                                  "_NET_WM_STATE_SHADED",
+                                  "_NET_WM_STATE_ABOVE",
+                                  "_NET_WM_STATE_BELOW",
+                                  "_NET_WM_STATE_SKIP_PAGER",
+                                  "_NET_WM_STATE_SKIP_TASKBAR",
+                                  "_KDE_NET_WM_STATE_SKIP_SWITCHER",
+                                  "_NET_WM_ALLOWED_ACTIONS",
+                                  "_NET_WM_ACTION_CLOSE",
+                                  "_NET_WM_ACTION_FULLSCREEN",
+                                  "_NET_WM_ACTION_MAXIMIZE_VERT",
+                                  "_NET_WM_ACTION_MAXIMIZE_HORZ",
+                                  "_NET_WM_ACTION_MINIMIZE",
+                                  "_NET_WM_ACTION_MOVE",
+                                  "_NET_WM_ACTION_RESIZE",
+                                  "_NET_WM_ACTION_SHADE",
+                                  "_NET_WM_ACTION_CHANGE_DESKTOP",
+                                  "_LATTE_INFOS_SENTINEL"};
+
+    xcb_connection_t *c = QX11Info::connection();
+
+    //! all atoms are requested first and afterwards their replies are collected
+    QList<xcb_intern_atom_cookie_t> cookies;
+
+    for (const auto &name : names) {
+        cookies << xcb_intern_atom(c, false, name.length(), name.constData());
+    }
+
+    for (int i=0; i<names.count(); ++i) {
+        QScopedPointer<xcb_intern_atom_reply_t, QScopedPointerPodDeleter> reply(xcb_intern_atom_reply(c, cookies[i], nullptr));
+        m_atoms[names[i]] = reply.isNull() ? (xcb_atom_t)XCB_ATOM_NONE : reply->atom;
+    }
+}
+
+void XWindowInterface::initInfosSentinel()
+{
+    xcb_connection_t *c = QX11Info::connection();
+    const uint32_t values[] = {1, XCB_EVENT_MASK_PROPERTY_CHANGE};
+
+    m_infosSentinelWindow = xcb_generate_id(c);
+    xcb_create_window(c, XCB_COPY_FROM_PARENT, m_infosSentinelWindow, QX11Info::appRootWindow(),
+                      -1, -1, 1, 1, 0, XCB_WINDOW_CLASS_INPUT_ONLY, XCB_COPY_FROM_PARENT,
+                      XCB_CW_OVERRIDE_REDIRECT | XCB_CW_EVENT_MASK, values);
+
+    //! the X server sends events and replies in the order of the requests, so the sentinel
+    //! event of a batch arrives only after all of the batch replies
+    X11EventDispatcher::self()->addHandler(XCB_PROPERTY_NOTIFY, this, [this](xcb_generic_event_t *event) {
+        auto propertyEvent = reinterpret_cast<xcb_property_notify_event_t *>(event);
+
+        if (propertyEvent->window != m_infosSentinelWindow) {
+            return;
+        }
+
+        if (m_canceledInfos > 0) {
+            m_canceledInfos--;
+            return;
+        }
+
+        if (m_completedInfos >= m_pendingInfos.count()) {
+            return;
+        }
+
+        m_completedInfos++;
+
+        if (!m_completedInfosTimer.isActive()) {
+            m_completedInfosTimer.start();
+        }
+    });
+}
+
+xcb_atom_t XWindowInterface::atom(const QByteArray &name) const
+{
+    return m_atoms.value(name, XCB_ATOM_NONE);
 }
 
 void XWindowInterface::setViewExtraFlags(QObject *view,bool isPanelWindow, Latte::Types::Visibility mode)
@@ -328,21 +496,6 @@ void XWindowInterface::setActiveEdge(QWindow *view, bool active)
     xcb_change_property(c, XCB_PROP_MODE_REPLACE, window->winId(), atom->atom, XCB_ATOM_CARDINAL, 32, 1, &value);
 }
 
-#if KF5_VERSION_MINOR >= 65
-QRect XWindowInterface::visibleGeometry(const WindowId &wid, const QRect &frameGeometry) const
-{
-    NETWinInfo ni(QX11Info::connection(), wid.toUInt(), QX11Info::appRootWindow(), 0, NET::WM2GTKFrameExtents);
-    NETStrut struts = ni.gtkFrameExtents();
-    QMargins margins(struts.left, struts.top, struts.right, struts.bottom);
-    QRect visibleGeometry = frameGeometry;
-
-    if (!margins.isNull()) {
-        visibleGeometry -= margins;
-    }
-
-    return visibleGeometry;
-}
-#endif
 
 
 void XWindowInterface::setFrameExtents(QWindow *view, const QMargins &margins)
@@ -389,9 +542,7 @@ void XWindowInterface::checkShapeExtension()
 {
     if (!m_shapeExtensionChecked) {
         xcb_connection_t *c = QX11Info::connection();
-        xcb_prefetch_extension_data(c, &xcb_shape_id);
-        const xcb_query_extension_reply_t *extension = xcb_get_extension_data(c, &xcb_shape_id);
-        if (extension->present) {
+        if (X11EventDispatcher::self()->extensionPresent(X11EventDispatcher::ShapeExtension)) {
             // query version
             auto cookie = xcb_shape_query_version(c);
             QScopedPointer<xcb_shape_query_version_reply_t, QScopedPointerPodDeleter> version(xcb_shape_query_version_reply(c, cookie, nullptr));
@@ -443,66 +594,334 @@ WindowInfoWrap XWindowInterface::requestInfoActive()
 
 WindowInfoWrap XWindowInterface::requestInfo(WindowId wid)
 {
-    const KWindowInfo winfo{wid.value<WId>(), NET::WMFrameExtents
-                | NET::WMWindowType
-                | NET::WMGeometry
-                | NET::WMDesktop
-                | NET::WMState
-                | NET::WMName
-                | NET::WMVisibleName,
-                NET::WM2WindowClass
-                | NET::WM2Activities
-                | NET::WM2AllowedActions
-                | NET::WM2TransientFor};
+    return requestInfos({wid}).first();
+}
+
+QList<WindowInfoWrap> XWindowInterface::requestInfos(const QList<WindowId> &wids, const QList<WindowProperties> &properties)
+{
+    if (wids.isEmpty()) {
+        return QList<WindowInfoWrap>();
+    }
+
+    //! a single round trip is needed for the entire batch
+    return receiveInfosBatch(sendInfosBatch(wids, properties));
+}
+
+void XWindowInterface::requestInfosAsync(const QList<WindowId> &wids, const QList<WindowProperties> &properties)
+{
+    if (wids.isEmpty()) {
+        emit windowInfosReceived(wids, QList<WindowInfoWrap>());
+        return;
+    }
+
+    xcb_connection_t *c = QX11Info::connection();
+    const uint32_t sentinelValue{0};
+
+    m_pendingInfos << sendInfosBatch(wids, properties);
+    xcb_change_property(c, XCB_PROP_MODE_REPLACE, m_infosSentinelWindow, atom("_LATTE_INFOS_SENTINEL"),
+                        XCB_ATOM_CARDINAL, 32, 1, &sentinelValue);
+    xcb_flush(c);
+}
+
+void XWindowInterface::cancelInfosAsync()
+{
+    m_completedInfosTimer.stop();
+
+    //! batches whose sentinel event has not arrived yet will still receive it later
+    m_canceledInfos += m_pendingInfos.count() - m_completedInfos;
+    m_completedInfos = 0;
+
+    for (const auto &batch : m_pendingInfos) {
+        discardInfosBatch(batch);
+    }
+
+    m_pendingInfos.clear();
+}
+
+void XWindowInterface::receiveCompletedInfos()
+{
+    //! replies of completed batches are already queued in the xcb connection, collecting them does not block
+    while (m_completedInfos > 0 && !m_pendingInfos.isEmpty()) {
+        InfosBatch received = m_pendingInfos.takeFirst();
+        m_completedInfos--;
+
+        emit windowInfosReceived(received.wids, receiveInfosBatch(received));
+    }
+}
+
+XWindowInterface::InfosBatch XWindowInterface::sendInfosBatch(const QList<WindowId> &wids, const QList<WindowProperties> &properties)
+{
+    InfosBatch batch;
+    batch.wids = wids;
+
+    for (int i=0; i<wids.count(); ++i) {
+        batch.requests << sendInfoRequest(wids[i], properties.value(i, AllWindowProperties));
+    }
+
+    return batch;
+}
+
+QList<WindowInfoWrap> XWindowInterface::receiveInfosBatch(const InfosBatch &batch)
+{
+    QList<WindowInfoWrap> infos;
+
+    for (const auto &request : batch.requests) {
+        infos << receiveInfoRequest(request);
+    }
+
+    return infos;
+}
+
+void XWindowInterface::discardInfosBatch(const InfosBatch &batch)
+{
+    xcb_connection_t *c = QX11Info::connection();
+
+    for (const auto &request : batch.requests) {
+        QList<unsigned int> sequences;
+
+        if (request.properties == AllWindowProperties) {
+            sequences << request.windowClass.sequence;
+        }
+
+        if (request.properties & GeometryWindowProperty) {
+            sequences << request.geometry.sequence << request.position.sequence
+                      << request.frameExtents.sequence << request.gtkFrameExtents.sequence;
+        }
+
+        if (request.properties & StateWindowProperty) {
+            sequences << request.state.sequence << request.allowedActions.sequence;
+        }
+
+        if (request.properties & NameWindowProperty) {
+            sequences << request.visibleName.sequence << request.name.sequence << request.wmName.sequence;
+        }
+
+        if (request.properties & DesktopWindowProperty) {
+            sequences << request.desktop.sequence;
+        }
+
+        if (request.properties & ActivitiesWindowProperty) {
+            sequences << request.activities.sequence;
+        }
+
+        if (request.properties & TransientWindowProperty) {
+            sequences << request.transientFor.sequence;
+        }
+
+        for (const auto sequence : sequences) {
+            xcb_discard_reply(c, sequence);
+        }
+    }
+}
+
+XWindowInterface::InfoRequest XWindowInterface::sendInfoRequest(const WindowId &wid, const WindowProperties &properties)
+{
+    xcb_connection_t *c = QX11Info::connection();
+    xcb_window_t window = wid.value<WId>();
+
+    InfoRequest request;
+    request.wid = wid;
+    request.properties = properties;
+
+    //! only the requested properties are sent to the X server, window class is
+    //! needed only for complete requests in order to identify acceptable windows
+    if (properties == AllWindowProperties) {
+        request.windowClass = xcb_get_property(c, false, window, XCB_ATOM_WM_CLASS, XCB_ATOM_STRING, 0, MAXPROPERTYLENGTH);
+    }
+
+    if (properties & GeometryWindowProperty) {
+        request.geometry = xcb_get_geometry(c, window);
+        request.position = xcb_translate_coordinates(c, window, QX11Info::appRootWindow(), 0, 0);
+        request.frameExtents = xcb_get_property(c, false, window, atom("_NET_FRAME_EXTENTS"), XCB_ATOM_CARDINAL, 0, 4);
+        request.gtkFrameExtents = xcb_get_property(c, false, window, atom("_GTK_FRAME_EXTENTS"), XCB_ATOM_CARDINAL, 0, 4);
+    }
+
+    if (properties & StateWindowProperty) {
+        request.state = xcb_get_property(c, false, window, atom("_NET_WM_STATE"), XCB_ATOM_ATOM, 0, MAXPROPERTYLENGTH);
+        request.allowedActions = xcb_get_property(c, false, window, atom("_NET_WM_ALLOWED_ACTIONS"), XCB_ATOM_ATOM, 0, MAXPROPERTYLENGTH);
+    }
+
+    if (properties & NameWindowProperty) {
+        request.visibleName = xcb_get_property(c, false, window, atom("_NET_WM_VISIBLE_NAME"), atom("UTF8_STRING"), 0, MAXPROPERTYLENGTH);
+        request.name = xcb_get_property(c, false, window, atom("_NET_WM_NAME"), atom("UTF8_STRING"), 0, MAXPROPERTYLENGTH);
+        request.wmName = xcb_get_property(c, false, window, XCB_ATOM_WM_NAME, XCB_GET_PROPERTY_TYPE_ANY, 0, MAXPROPERTYLENGTH);
+    }
+
+    if (properties & DesktopWindowProperty) {
+        request.desktop = xcb_get_property(c, false, window, atom("_NET_WM_DESKTOP"), XCB_ATOM_CARDINAL, 0, 1);
+    }
+
+    if (properties & ActivitiesWindowProperty) {
+        request.activities = xcb_get_property(c, false, window, atom("_KDE_NET_WM_ACTIVITIES"), XCB_ATOM_STRING, 0, MAXPROPERTYLENGTH);
+    }
+
+    if (properties & TransientWindowProperty) {
+        request.transientFor = xcb_get_property(c, false, window, XCB_ATOM_WM_TRANSIENT_FOR, XCB_ATOM_WINDOW, 0, 1);
+    }
+
+    return request;
+}
+
+WindowInfoWrap XWindowInterface::receiveInfoRequest(const InfoRequest &request)
+{
+    xcb_connection_t *c = QX11Info::connection();
+    const WindowId wid = request.wid;
+    const WindowProperties properties = request.properties;
+    const bool completeRequest = (properties == AllWindowProperties);
+
+    //! all sent requests must be collected even when the window is not valid
+    QScopedPointer<xcb_get_geometry_reply_t, QScopedPointerPodDeleter> geometryReply;
+    QScopedPointer<xcb_translate_coordinates_reply_t, QScopedPointerPodDeleter> positionReply;
+    QByteArray windowClass;
+    QVector<quint32> transientFor;
+    QVector<quint32> state;
+    QVector<quint32> desktop;
+    QByteArray activities;
+    QVector<quint32> allowedActions;
+    QVector<quint32> frameExtents;
+    QVector<quint32> gtkFrameExtents;
+    QByteArray visibleName;
+    QByteArray name;
+    QByteArray wmName;
+
+    if (completeRequest) {
+        windowClass = propertyValue(c, request.windowClass);
+    }
+
+    if (properties & GeometryWindowProperty) {
+        geometryReply.reset(xcb_get_geometry_reply(c, request.geometry, nullptr));
+        positionReply.reset(xcb_translate_coordinates_reply(c, request.position, nullptr));
+        frameExtents = propertyValues(c, request.frameExtents);
+        gtkFrameExtents = propertyValues(c, request.gtkFrameExtents);
+    }
+
+    if (properties & StateWindowProperty) {
+        state = propertyValues(c, request.state);
+        allowedActions = propertyValues(c, request.allowedActions);
+    }
+
+    if (properties & NameWindowProperty) {
+        visibleName = propertyValue(c, request.visibleName);
+        name = propertyValue(c, request.name);
+        wmName = propertyValue(c, request.wmName);
+    }
+
+    if (properties & DesktopWindowProperty) {
+        desktop = propertyValues(c, request.desktop);
+    }
+
+    if (properties & ActivitiesWindowProperty) {
+        activities = propertyValue(c, request.activities);
+    }
+
+    if (properties & TransientWindowProperty) {
+        transientFor = propertyValues(c, request.transientFor);
+    }
 
     WindowInfoWrap winfoWrap;
 
-    const auto winClass = QString(winfo.windowClassName());
+    bool valid = !(properties & GeometryWindowProperty) || (!geometryReply.isNull() && !positionReply.isNull());
+
+    //! WM_CLASS contains the instance name followed by the class name
+    const auto winClass = QString::fromLatin1(windowClass.constData());
+
+    QRect geometry;
+
+    if (valid && (properties & GeometryWindowProperty)) {
+        geometry = QRect(positionReply->dst_x, positionReply->dst_y, geometryReply->width, geometryReply->height);
+    }
+
+    auto hasState = [&](const char *stateName) {
+        return state.contains(atom(stateName));
+    };
+
+    bool hasSkipTaskbar = hasState("_NET_WM_STATE_SKIP_TASKBAR");
+    bool hasSkipPager = hasState("_NET_WM_STATE_SKIP_PAGER");
 
     //!used to track Plasma DesktopView windows because during startup can not be identified properly
-    bool plasmaBlockedWindow = (winClass == QLatin1String("plasmashell") && !isAcceptableWindow(wid));
+    bool plasmaBlockedWindow = (completeRequest
+                                && valid
+                                && winClass == QLatin1String("plasmashell")
+                                && !isAcceptableWindow(wid, winClass, geometry, hasSkipTaskbar, hasSkipPager));
 
-    if (!winfo.valid() || plasmaBlockedWindow) {
+    if (!valid || plasmaBlockedWindow) {
         winfoWrap.setIsValid(false);
-    } else if (isValidWindow(wid)) {
+    } else if (!completeRequest
+               || windowsTracker()->isValidFor(wid)
+               || isAcceptableWindow(wid, winClass, geometry, hasSkipTaskbar, hasSkipPager)) {
+        //! partial requests concern only already tracked windows and they provide only the requested properties
         winfoWrap.setIsValid(true);
         winfoWrap.setWid(wid);
-        winfoWrap.setParentId(winfo.transientFor());
-        winfoWrap.setIsActive(KWindowSystem::activeWindow() == wid.value<WId>());
-        winfoWrap.setIsMinimized(winfo.hasState(NET::Hidden));
-        winfoWrap.setIsMaxVert(winfo.hasState(NET::MaxVert));
-        winfoWrap.setIsMaxHoriz(winfo.hasState(NET::MaxHoriz));
-        winfoWrap.setIsFullscreen(winfo.hasState(NET::FullScreen));
-        winfoWrap.setIsShaded(winfo.hasState(NET::Shaded));
-        winfoWrap.setIsOnAllDesktops(winfo.onAllDesktops());
-        winfoWrap.setIsOnAllActivities(winfo.activities().empty());
+
+        if (properties & TransientWindowProperty) {
+            winfoWrap.setParentId(transientFor.isEmpty() ? 0 : transientFor[0]);
+        }
+
+        if (properties & ActiveWindowProperty) {
+            winfoWrap.setIsActive(KWindowSystem::activeWindow() == wid.value<WId>());
+        }
+
+        if (properties & StateWindowProperty) {
+            auto actionSupported = [&](const char *actionName) {
+                return !KWindowSystem::allowedActionsSupported() || allowedActions.contains(atom(actionName));
+            };
+
+            winfoWrap.setIsMinimized(hasState("_NET_WM_STATE_HIDDEN"));
+            winfoWrap.setIsMaxVert(hasState("_NET_WM_STATE_MAXIMIZED_VERT"));
+            winfoWrap.setIsMaxHoriz(hasState("_NET_WM_STATE_MAXIMIZED_HORZ"));
+            winfoWrap.setIsFullscreen(hasState("_NET_WM_STATE_FULLSCREEN"));
+            winfoWrap.setIsShaded(hasState("_NET_WM_STATE_SHADED"));
+            winfoWrap.setIsKeepAbove(hasState("_NET_WM_STATE_ABOVE"));
+            winfoWrap.setIsKeepBelow(hasState("_NET_WM_STATE_BELOW"));
+            winfoWrap.setHasSkipPager(hasSkipPager);
+#if KF5_VERSION_MINOR >= 45
+            winfoWrap.setHasSkipSwitcher(hasState("_KDE_NET_WM_STATE_SKIP_SWITCHER"));
+#endif
+            winfoWrap.setHasSkipTaskbar(hasSkipTaskbar);
+
+            //! BEGIN:Window Abilities
+            winfoWrap.setIsClosable(actionSupported("_NET_WM_ACTION_CLOSE"));
+            winfoWrap.setIsFullScreenable(actionSupported("_NET_WM_ACTION_FULLSCREEN"));
+            winfoWrap.setIsMaximizable(actionSupported("_NET_WM_ACTION_MAXIMIZE_VERT") || actionSupported("_NET_WM_ACTION_MAXIMIZE_HORZ"));
+            winfoWrap.setIsMinimizable(actionSupported("_NET_WM_ACTION_MINIMIZE"));
+            winfoWrap.setIsMovable(actionSupported("_NET_WM_ACTION_MOVE"));
+            winfoWrap.setIsResizable(actionSupported("_NET_WM_ACTION_RESIZE"));
+            winfoWrap.setIsShadeable(actionSupported("_NET_WM_ACTION_SHADE"));
+            winfoWrap.setIsVirtualDesktopsChangeable(actionSupported("_NET_WM_ACTION_CHANGE_DESKTOP"));
+            //! END:Window Abilities
+        }
+
+        if (properties & GeometryWindowProperty) {
+            QRect frameGeometry = geometry + extentsMargins(frameExtents);
 #if KF5_VERSION_MINOR >= 65
-        winfoWrap.setGeometry(visibleGeometry(wid, winfo.frameGeometry()));
+            winfoWrap.setGeometry(frameGeometry - extentsMargins(gtkFrameExtents));
 #else
-        winfoWrap.setGeometry(winfo.frameGeometry());
-#endif
-        winfoWrap.setIsKeepAbove(winfo.hasState(NET::KeepAbove));
-        winfoWrap.setIsKeepBelow(winfo.hasState(NET::KeepBelow));
-        winfoWrap.setHasSkipPager(winfo.hasState(NET::SkipPager));
-#if KF5_VERSION_MINOR >= 45
-        winfoWrap.setHasSkipSwitcher(winfo.hasState(NET::SkipSwitcher));
+            winfoWrap.setGeometry(frameGeometry);
 #endif
-        winfoWrap.setHasSkipTaskbar(winfo.hasState(NET::SkipTaskbar));
+        }
+
+        if (properties & NameWindowProperty) {
+            winfoWrap.setDisplay(QString::fromUtf8(!visibleName.isEmpty() ? visibleName : (!name.isEmpty() ? name : wmName)));
+        }
 
-        //! BEGIN:Window Abilities
-        winfoWrap.setIsClosable(winfo.actionSupported(NET::ActionClose));
-        winfoWrap.setIsFullScreenable(winfo.actionSupported(NET::ActionFullScreen));
-        winfoWrap.setIsMaximizable(winfo.actionSupported(NET::ActionMax));
-        winfoWrap.setIsMinimizable(winfo.actionSupported(NET::ActionMinimize));
-        winfoWrap.setIsMovable(winfo.actionSupported(NET::ActionMove));
-        winfoWrap.setIsResizable(winfo.actionSupported(NET::ActionResize));
-        winfoWrap.setIsShadeable(winfo.actionSupported(NET::ActionShade));
-        winfoWrap.setIsVirtualDesktopsChangeable(winfo.actionSupported(NET::ActionChangeDesktop));
-        //! END:Window Abilities
+        if (properties & DesktopWindowProperty) {
+            //! desktops are counted from 1 and -1 means all desktops, same as NETWinInfo
+            int desktopId = desktop.isEmpty() ? 0 : (desktop[0] == 0xFFFFFFFF ? (int)NET::OnAllDesktops : (int)desktop[0] + 1);
 
-        winfoWrap.setDisplay(winfo.visibleName());
-        winfoWrap.setDesktops({QString(winfo.desktop())});
-        winfoWrap.setActivities(winfo.activities());
+            winfoWrap.setIsOnAllDesktops(desktopId == NET::OnAllDesktops);
+            winfoWrap.setDesktops({QString(desktopId)});
+        }
+
+        if (properties & ActivitiesWindowProperty) {
+            QStringList windowActivities = QString::fromLatin1(activities).split(QLatin1Char(','), QString::SkipEmptyParts);
+
+            if (windowActivities.contains(QLatin1String(ALLACTIVITIESUUID))) {
+                windowActivities.clear();
+            }
+
+            winfoWrap.setIsOnAllActivities(windowActivities.empty());
+            winfoWrap.setActivities(windowActivities);
+        }
     }
 
     if (plasmaBlockedWindow) {
@@ -514,10 +933,14 @@ WindowInfoWrap XWindowInterface::requestInfo(WindowId wid)
 
 AppData XWindowInterface::appDataFor(WindowId wid)
 {
-    return appDataFromUrl(windowUrl(wid));
+    bool pending{false};
+    AppData data = appDataFromUrl(windowUrl(wid, &pending));
+    data.pending = pending;
+
+    return data;
 }
 
-QUrl XWindowInterface::windowUrl(WindowId wid)
+QUrl XWindowInterface::windowUrl(WindowId wid, bool *pending)
 {
     const KWindowInfo info(wid.value<WId>(), 0, NET::WM2WindowClass | NET::WM2DesktopFileName);
 
@@ -547,9 +970,11 @@ QUrl XWindowInterface::windowUrl(WindowId wid)
         }
     }
 
-    return windowUrlFromMetadata(info.windowClassClass(),
-                                 NETWinInfo(QX11Info::connection(), wid.value<WId>(), QX11Info::appRootWindow(), NET::WMPid, NET::Properties2()).pid(),
-                                 rulesConfig, info.windowClassName());
+    return AppIdentityCache::self()->windowUrl(wid,
+                                               info.windowClassClass(),
+                                               NETWinInfo(QX11Info::connection(), wid.value<WId>(), QX11Info::appRootWindow(), NET::WMPid, NET::Properties2()).pid(),
+                                               info.windowClassName(),
+                                               pending);
 }
 
 bool XWindowInterface::windowCanBeDragged(WindowId wid)
@@ -756,10 +1181,28 @@ bool XWindowInterface::isValidWindow(WindowId wid)
 
 bool XWindowInterface::isAcceptableWindow(WindowId wid)
 {
+    //! registrations are always checked first because they can change at any time
+    if (hasBlockedTracking(wid)) {
+        return false;
+    }
+
+    if (isWhitelistedWindow(wid)) {
+        return true;
+    }
+
+    auto classification = m_acceptedWindows.constFind(wid);
+
+    if (classification != m_acceptedWindows.constEnd()) {
+        return classification.value();
+    }
+
     const KWindowInfo info(wid.toUInt(), NET::WMGeometry | NET::WMState, NET::WM2WindowClass);
 
-    const auto winClass = QString(info.windowClassName());
+    return isAcceptableWindow(wid, QString(info.windowClassName()), info.geometry(), info.hasState(NET::SkipTaskbar), info.hasState(NET::SkipPager));
+}
 
+bool XWindowInterface::isAcceptableWindow(WindowId wid, const QString &winClass, const QRect &geometry, bool hasSkipTaskbar, bool hasSkipPager)
+{
     //! ignored windows do not trackd
     if (hasBlockedTracking(wid)) {
         return false;
@@ -771,8 +1214,6 @@ bool XWindowInterface::isAcceptableWindow(WindowId wid)
     }
 
     //! Window Checks
-    bool hasSkipTaskbar = info.hasState(NET::SkipTaskbar);
-    bool hasSkipPager = info.hasState(NET::SkipPager);
     bool isSkipped = hasSkipTaskbar && hasSkipPager;
 
     if (isSkipped
@@ -780,21 +1221,23 @@ bool XWindowInterface::isAcceptableWindow(WindowId wid)
                  || (winClass == QLatin1String("krunner"))) )) {
         registerWhitelistedWindow(wid);
     } else if (winClass == QLatin1String("plasmashell")) {
-        if (isSkipped && isSidepanel(info.geometry())) {
+        if (isSkipped && isSidepanel(geometry)) {
             registerWhitelistedWindow(wid);
             return true;
-        } else if (isPlasmaPanel(info.geometry()) || isFullScreenWindow(info.geometry())) {
+        } else if (isPlasmaPanel(geometry) || isFullScreenWindow(geometry)) {
             registerPlasmaIgnoredWindow(wid);
             return false;
         }
     } else if ((winClass == QLatin1String("latte-dock"))
                || (winClass == QLatin1String("ksmserver"))) {
-        if (isFullScreenWindow(info.geometry())) {
+        if (isFullScreenWindow(geometry)) {
             registerIgnoredWindow(wid);
             return false;
         }
     }
 
+    m_acceptedWindows[wid] = !isSkipped;
+
     return !isSkipped;
 }
 
@@ -810,30 +1253,55 @@ void XWindowInterface::windowAddedProxy(WId wid)
 
 void XWindowInterface::windowChangedProxy(WId wid, NET::Properties prop1, NET::Properties2 prop2)
 {
+    if ((prop1 & (NET::WMState | NET::WMGeometry)) || (prop2 & NET::WM2WindowClass)) {
+        //! window classification must be evaluated again
+        m_acceptedWindows.remove(WindowKey(wid));
+    }
+
     if (!isValidWindow(wid)) {
         return;
     }
 
-    //! accept only NET::Properties events,
+    //! only the changed window information needs to be requested again
+    WindowProperties properties{NoWindowProperty};
+
+    if (prop1 & (NET::WMGeometry | NET::WMFrameExtents)) {
+        properties |= GeometryWindowProperty;
+    }
+
+    if (prop1 & NET::WMState) {
+        properties |= StateWindowProperty;
+    }
+
+    if (prop1 & NET::ActiveWindow) {
+        properties |= ActiveWindowProperty;
+    }
+
+    if (prop1 & (NET::WMName | NET::WMVisibleName)) {
+        properties |= NameWindowProperty;
+    }
+
+    if (prop1 & NET::WMDesktop) {
+        properties |= DesktopWindowProperty;
+    }
+
+    if (prop2 & NET::WM2Activities) {
+        properties |= ActivitiesWindowProperty;
+    }
+
+    if (prop2 & NET::WM2TransientFor) {
+        properties |= TransientWindowProperty;
+    }
+
+    //! accept only the NET::Properties that are tracked,
     //! ignore when the user presses a key, or a window is sending X events etc.
     //! without needing to (e.g. Firefox, https://bugzilla.mozilla.org/show_bug.cgi?id=1389953)
     //! NET::WM2UserTime, NET::WM2IconPixmap etc....
-    if (prop1 == 0 && !(prop2 & (NET::WM2Activities | NET::WM2TransientFor))) {
+    if (!properties) {
         return;
     }
 
-    //! accept only the following NET:Properties changed signals
-    //! NET::WMState, NET::WMGeometry, NET::ActiveWindow
-    if ( !(prop1 & NET::WMState)
-         && !(prop1 & NET::WMGeometry)
-         && !(prop1 & NET::ActiveWindow)
-         && !(prop1 & (NET::WMName | NET::WMVisibleName)
-              && !(prop2 & NET::WM2TransientFor)
-              && !(prop2 & NET::WM2Activities)) ) {
-        return;
-    }
-
-    considerWindowChanged(wid);
+    considerWindowChanged(wid, properties);
 }
 
 }
@@ -28,11 +28,16 @@
 
 // Qt
 #include <QObject>
+#include <QHash>
+#include <QTimer>
 
 // KDE
 #include <KWindowInfo>
 #include <KWindowEffects>
 
+// X11
+#include <xcb/xcb.h>
+
 
 namespace Latte {
 namespace WindowSystem {
@@ -55,6 +60,10 @@ public:
     WindowInfoWrap requestInfo(WindowId wid) override;
     WindowInfoWrap requestInfoActive() override;
 
+    QList<WindowInfoWrap> requestInfos(const QList<WindowId> &wids, const QList<WindowProperties> &properties = QList<WindowProperties>()) override;
+    void requestInfosAsync(const QList<WindowId> &wids, const QList<WindowProperties> &properties = QList<WindowProperties>()) override;
+    void cancelInfosAsync() override;
+
     void skipTaskBar(const QDialog &dialog) override;
     void slideWindow(QWindow &view, Slide location) override;
     void enableBlurBehind(QWindow &view) override;
@@ -86,17 +95,56 @@ public:
     void setInputMask(QWindow *window, const QRect &rect) override;
 
 private:
+    //! pending xcb cookies of a single window information request, only the cookies
+    //! of the requested properties are valid
+    struct InfoRequest
+    {
+        WindowId wid;
+        WindowProperties properties{AllWindowProperties};
+        xcb_get_geometry_cookie_t geometry;
+        xcb_translate_coordinates_cookie_t position;
+        xcb_get_property_cookie_t windowClass;
+        xcb_get_property_cookie_t transientFor;
+        xcb_get_property_cookie_t state;
+        xcb_get_property_cookie_t desktop;
+        xcb_get_property_cookie_t activities;
+        xcb_get_property_cookie_t allowedActions;
+        xcb_get_property_cookie_t frameExtents;
+        xcb_get_property_cookie_t gtkFrameExtents;
+        xcb_get_property_cookie_t visibleName;
+        xcb_get_property_cookie_t name;
+        xcb_get_property_cookie_t wmName;
+    };
+
+    //! window information requests that were sent together. Asynchronous batches are followed by
+    //! a property change of the sentinel window and when its PropertyNotify event is delivered
+    //! all batch replies have already been read from the X server
+    struct InfosBatch
+    {
+        QList<WindowId> wids;
+        QList<InfoRequest> requests;
+    };
+
     bool isAcceptableWindow(WindowId wid);
+    bool isAcceptableWindow(WindowId wid, const QString &winClass, const QRect &geometry, bool hasSkipTaskbar, bool hasSkipPager);
     bool isValidWindow(WindowId wid);
 
-#if KF5_VERSION_MINOR >= 65
-    QRect visibleGeometry(const WindowId &wid, const QRect &frameGeometry) const;
-#endif
+    void initAtoms();
+    void initInfosSentinel();
+    xcb_atom_t atom(const QByteArray &name) const;
+
+    InfosBatch sendInfosBatch(const QList<WindowId> &wids, const QList<WindowProperties> &properties);
+    QList<WindowInfoWrap> receiveInfosBatch(const InfosBatch &batch);
+    void discardInfosBatch(const InfosBatch &batch);
+    InfoRequest sendInfoRequest(const WindowId &wid, const WindowProperties &properties);
+    WindowInfoWrap receiveInfoRequest(const InfoRequest &request);
+
+    void receiveCompletedInfos();
 
     void windowAddedProxy(WId wid);
     void windowChangedProxy(WId wid, NET::Properties prop1, NET::Properties2 prop2);
 
-    QUrl windowUrl(WindowId wid);
+    QUrl windowUrl(WindowId wid, bool *pending);
 
     void checkShapeExtension();
 
@@ -104,6 +152,23 @@ private:
     //xcb_shape
     bool m_shapeExtensionChecked{false};
     bool m_shapeAvailable{false};
+
+    //! cached acceptable windows classification, it is evaluated when windows appear and
+    //! again only when their class, state or geometry changes
+    QHash<WindowKey, bool> m_acceptedWindows;
+
+    //! interned atoms used for window information requests
+    QHash<QByteArray, xcb_atom_t> m_atoms;
+
+    //! asynchronous window information batches in the order they were sent
+    QList<InfosBatch> m_pendingInfos;
+    //! pending batches at the front whose replies have arrived
+    int m_completedInfos{0};
+    //! sentinel events of canceled batches that have not arrived yet
+    int m_canceledInfos{0};
+    //! unmapped input only window whose property changes mark the end of asynchronous batches
+    xcb_window_t m_infosSentinelWindow{XCB_WINDOW_NONE};
+    QTimer m_completedInfosTimer;
 };
 
 }
@@ -0,0 +1,523 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "syntheticinterface.h"
+
+// Qt
+#include <QGuiApplication>
+#include <QScreen>
+
+
+namespace Latte {
+namespace WindowSystem {
+
+//! synthetic window ids are kept far away from the real window ids
+//! that are registered by Latte views and dialogs
+const quint64 SYNTHETICWINDOWIDBASE = 0x7F000000;
+
+SyntheticInterface::SyntheticInterface(QObject *parent)
+    : AbstractWindowInterface(parent)
+{
+    m_nextWindowId = SYNTHETICWINDOWIDBASE;
+    setDesktopsCount(1);
+}
+
+SyntheticInterface::~SyntheticInterface()
+{
+}
+
+void SyntheticInterface::setViewExtraFlags(QObject *view, bool isPanelWindow, Latte::Types::Visibility mode)
+{
+    Q_UNUSED(view);
+    Q_UNUSED(isPanelWindow);
+    Q_UNUSED(mode);
+}
+
+void SyntheticInterface::setViewStruts(QWindow &view, const QRect &rect, Plasma::Types::Location location)
+{
+    Q_UNUSED(view);
+    Q_UNUSED(rect);
+    Q_UNUSED(location);
+}
+
+void SyntheticInterface::setWindowOnActivities(QWindow &view, const QStringList &activities)
+{
+    Q_UNUSED(view);
+    Q_UNUSED(activities);
+}
+
+void SyntheticInterface::removeViewStruts(QWindow &view)
+{
+    Q_UNUSED(view);
+}
+
+WindowId SyntheticInterface::activeWindow()
+{
+    return m_activeWindow;
+}
+
+WindowInfoWrap SyntheticInterface::requestInfo(WindowId wid)
+{
+    WindowKey key(wid);
+
+    if (!m_windows.contains(key)) {
+        WindowInfoWrap winfo;
+        winfo.setIsValid(false);
+        return winfo;
+    }
+
+    return m_windows[key];
+}
+
+WindowInfoWrap SyntheticInterface::requestInfoActive()
+{
+    return requestInfo(m_activeWindow);
+}
+
+void SyntheticInterface::skipTaskBar(const QDialog &dialog)
+{
+    Q_UNUSED(dialog);
+}
+
+void SyntheticInterface::slideWindow(QWindow &view, Slide location)
+{
+    Q_UNUSED(view);
+    Q_UNUSED(location);
+}
+
+void SyntheticInterface::enableBlurBehind(QWindow &view)
+{
+    Q_UNUSED(view);
+}
+
+void SyntheticInterface::requestActivate(WindowId wid)
+{
+    activateWindow(wid);
+}
+
+void SyntheticInterface::requestClose(WindowId wid)
+{
+    closeWindow(wid);
+}
+
+void SyntheticInterface::requestMoveWindow(WindowId wid, QPoint from)
+{
+    Q_UNUSED(wid);
+    Q_UNUSED(from);
+}
+
+void SyntheticInterface::requestToggleIsOnAllDesktops(WindowId wid)
+{
+    WindowKey key(wid);
+
+    if (!m_windows.contains(key)) {
+        return;
+    }
+
+    WindowInfoWrap winfo = m_windows[key];
+    winfo.setIsOnAllDesktops(!winfo.isOnAllDesktops());
+    updateWindow(wid, winfo, DesktopWindowProperty);
+}
+
+void SyntheticInterface::requestToggleKeepAbove(WindowId wid)
+{
+    WindowKey key(wid);
+
+    if (m_windows.contains(key)) {
+        setKeepAbove(wid, !m_windows[key].isKeepAbove());
+    }
+}
+
+void SyntheticInterface::requestToggleMinimized(WindowId wid)
+{
+    WindowKey key(wid);
+
+    if (m_windows.contains(key)) {
+        setMinimized(wid, !m_windows[key].isMinimized());
+    }
+}
+
+void SyntheticInterface::requestToggleMaximized(WindowId wid)
+{
+    WindowKey key(wid);
+
+    if (m_windows.contains(key)) {
+        setMaximized(wid, !m_windows[key].isMaximized());
+    }
+}
+
+void SyntheticInterface::setKeepAbove(WindowId wid, bool active)
+{
+    WindowKey key(wid);
+
+    if (!m_windows.contains(key) || m_windows[key].isKeepAbove() == active) {
+        return;
+    }
+
+    WindowInfoWrap winfo = m_windows[key];
+    winfo.setIsKeepAbove(active);
+    updateWindow(wid, winfo, StateWindowProperty);
+}
+
+void SyntheticInterface::setKeepBelow(WindowId wid, bool active)
+{
+    WindowKey key(wid);
+
+    if (!m_windows.contains(key) || m_windows[key].isKeepBelow() == active) {
+        return;
+    }
+
+    WindowInfoWrap winfo = m_windows[key];
+    winfo.setIsKeepBelow(active);
+    updateWindow(wid, winfo, StateWindowProperty);
+}
+
+bool SyntheticInterface::windowCanBeDragged(WindowId wid)
+{
+    WindowInfoWrap winfo = requestInfo(wid);
+    return (winfo.isValid() && !winfo.isMinimized() && winfo.isMovable());
+}
+
+bool SyntheticInterface::windowCanBeMaximized(WindowId wid)
+{
+    WindowInfoWrap winfo = requestInfo(wid);
+    return (winfo.isValid() && !winfo.isMinimized() && winfo.isMaximizable());
+}
+
+QIcon SyntheticInterface::iconFor(WindowId wid)
+{
+    Q_UNUSED(wid);
+    return QIcon::fromTheme(QStringLiteral("application-x-executable"));
+}
+
+WindowId SyntheticInterface::winIdFor(QString appId, QRect geometry)
+{
+    for (const auto &winfo : m_windows) {
+        if (winfo.appName() == appId && winfo.geometry() == geometry) {
+            return winfo.wid();
+        }
+    }
+
+    return QVariant();
+}
+
+WindowId SyntheticInterface::winIdFor(QString appId, QString title)
+{
+    for (const auto &winfo : m_windows) {
+        if (winfo.appName() == appId && winfo.display() == title) {
+            return winfo.wid();
+        }
+    }
+
+    return QVariant();
+}
+
+AppData SyntheticInterface::appDataFor(WindowId wid)
+{
+    AppData data;
+    WindowKey key(wid);
+
+    if (m_windows.contains(key)) {
+        data.id = m_windows[key].appName();
+        data.name = data.id;
+        data.icon = iconFor(wid);
+    }
+
+    return data;
+}
+
+void SyntheticInterface::setActiveEdge(QWindow *view, bool active)
+{
+    Q_UNUSED(view);
+    Q_UNUSED(active);
+}
+
+void SyntheticInterface::switchToNextVirtualDesktop()
+{
+    int curPos = m_desktops.indexOf(m_currentDesktop);
+    setCurrentDesktop(m_desktops[(curPos + 1) % m_desktops.count()]);
+}
+
+void SyntheticInterface::switchToPreviousVirtualDesktop()
+{
+    int curPos = m_desktops.indexOf(m_currentDesktop);
+    setCurrentDesktop(m_desktops[(curPos - 1 + m_desktops.count()) % m_desktops.count()]);
+}
+
+void SyntheticInterface::setFrameExtents(QWindow *view, const QMargins &margins)
+{
+    Q_UNUSED(view);
+    Q_UNUSED(margins);
+}
+
+void SyntheticInterface::setInputMask(QWindow *window, const QRect &rect)
+{
+    Q_UNUSED(window);
+    Q_UNUSED(rect);
+}
+
+QList<WindowId> SyntheticInterface::windows() const
+{
+    QList<WindowId> wids;
+
+    for (const auto &winfo : m_windows) {
+        wids << winfo.wid();
+    }
+
+    return wids;
+}
+
+QStringList SyntheticInterface::desktops() const
+{
+    return m_desktops;
+}
+
+void SyntheticInterface::setDesktopsCount(int count)
+{
+    m_desktops.clear();
+
+    for (int i=1; i<=qMax(1, count); ++i) {
+        m_desktops << QString::number(i);
+    }
+
+    if (!m_desktops.contains(m_currentDesktop)) {
+        setCurrentDesktop(m_desktops.first());
+    }
+}
+
+void SyntheticInterface::setCurrentDesktop(const QString &desktop)
+{
+    if (m_currentDesktop == desktop) {
+        return;
+    }
+
+    if (!m_desktops.contains(desktop)) {
+        m_desktops << desktop;
+    }
+
+    m_currentDesktop = desktop;
+    emit currentDesktopChanged();
+}
+
+void SyntheticInterface::setCurrentActivity(const QString &activity)
+{
+    if (m_currentActivity == activity) {
+        return;
+    }
+
+    m_currentActivity = activity;
+    emit currentActivityChanged();
+}
+
+WindowId SyntheticInterface::createWindow(const QString &appName, const QRect &geometry, const QString &desktop, const QStringList &activities)
+{
+    WindowId wid = WindowId(static_cast<qulonglong>(m_nextWindowId++));
+
+    WindowInfoWrap winfo;
+    winfo.setIsValid(true);
+    winfo.setWid(wid);
+    winfo.setAppName(appName);
+    winfo.setDisplay(appName);
+    winfo.setGeometry(geometry);
+
+    winfo.setIsOnAllDesktops(desktop.isEmpty());
+    winfo.setDesktops(desktop.isEmpty() ? QStringList() : QStringList(desktop));
+    winfo.setIsOnAllActivities(activities.isEmpty());
+    winfo.setActivities(activities);
+
+    //! BEGIN:Window Abilities
+    winfo.setIsClosable(true);
+    winfo.setIsFullScreenable(true);
+    winfo.setIsMaximizable(true);
+    winfo.setIsMinimizable(true);
+    winfo.setIsMovable(true);
+    winfo.setIsResizable(true);
+    winfo.setIsShadeable(true);
+    winfo.setIsVirtualDesktopsChangeable(true);
+    //! END:Window Abilities
+
+    m_windows[wid] = winfo;
+
+    emit windowAdded(wid);
+
+    return wid;
+}
+
+void SyntheticInterface::closeWindow(const WindowId &wid)
+{
+    WindowKey key(wid);
+
+    if (!m_windows.contains(key)) {
+        return;
+    }
+
+    if (m_activeWindow == wid) {
+        setActiveWindow(QVariant());
+    }
+
+    removeWindow(wid);
+}
+
+void SyntheticInterface::moveWindow(const WindowId &wid, const QRect &geometry)
+{
+    WindowKey key(wid);
+
+    if (!m_windows.contains(key) || m_windows[key].geometry() == geometry) {
+        return;
+    }
+
+    WindowInfoWrap winfo = m_windows[key];
+    winfo.setGeometry(geometry);
+    winfo.setIsMaxVert(false);
+    winfo.setIsMaxHoriz(false);
+    m_restoreGeometries.remove(key);
+
+    updateWindow(wid, winfo, GeometryWindowProperty | StateWindowProperty);
+}
+
+void SyntheticInterface::setWindowTitle(const WindowId &wid, const QString &title)
+{
+    WindowKey key(wid);
+
+    if (!m_windows.contains(key) || m_windows[key].display() == title) {
+        return;
+    }
+
+    WindowInfoWrap winfo = m_windows[key];
+    winfo.setDisplay(title);
+    updateWindow(wid, winfo, NameWindowProperty);
+}
+
+void SyntheticInterface::setMaximized(const WindowId &wid, bool maximized)
+{
+    WindowKey key(wid);
+
+    if (!m_windows.contains(key) || m_windows[key].isMaximized() == maximized) {
+        return;
+    }
+
+    WindowInfoWrap winfo = m_windows[key];
+
+    if (maximized) {
+        //! windows are maximized in the available geometry of the screen that contains their center
+        QRect maximizedGeometry = winfo.geometry();
+
+        for (const auto scr : qGuiApp->screens()) {
+            if (scr->geometry().contains(winfo.geometry().center())) {
+                maximizedGeometry = scr->availableGeometry();
+                break;
+            }
+        }
+
+        m_restoreGeometries[key] = winfo.geometry();
+        winfo.setGeometry(maximizedGeometry);
+    } else if (m_restoreGeometries.contains(key)) {
+        winfo.setGeometry(m_restoreGeometries.take(key));
+    }
+
+    winfo.setIsMaxVert(maximized);
+    winfo.setIsMaxHoriz(maximized);
+
+    updateWindow(wid, winfo, GeometryWindowProperty | StateWindowProperty);
+}
+
+void SyntheticInterface::setMinimized(const WindowId &wid, bool minimized)
+{
+    WindowKey key(wid);
+
+    if (!m_windows.contains(key) || m_windows[key].isMinimized() == minimized) {
+        return;
+    }
+
+    WindowInfoWrap winfo = m_windows[key];
+    winfo.setIsMinimized(minimized);
+
+    if (minimized && winfo.isActive()) {
+        winfo.setIsActive(false);
+        m_activeWindow = QVariant();
+        updateWindow(wid, winfo, StateWindowProperty | ActiveWindowProperty);
+        emit activeWindowChanged(m_activeWindow);
+        return;
+    }
+
+    updateWindow(wid, winfo, StateWindowProperty);
+}
+
+void SyntheticInterface::activateWindow(const WindowId &wid)
+{
+    WindowKey key(wid);
+
+    if (!m_windows.contains(key) || m_activeWindow == wid) {
+        return;
+    }
+
+    if (m_windows[key].isMinimized()) {
+        m_windows[key].setIsMinimized(false);
+        emit windowChanged(wid, StateWindowProperty);
+    }
+
+    setActiveWindow(wid);
+}
+
+void SyntheticInterface::addWindow(const WindowInfoWrap &winfo)
+{
+    m_windows[winfo.wid()] = winfo;
+    emit windowAdded(winfo.wid());
+}
+
+void SyntheticInterface::changeWindow(const WindowInfoWrap &winfo, const WindowProperties &properties)
+{
+    updateWindow(winfo.wid(), winfo, properties);
+}
+
+void SyntheticInterface::removeWindow(const WindowId &wid)
+{
+    m_windows.remove(wid);
+    m_restoreGeometries.remove(wid);
+
+    emit windowRemoved(wid);
+}
+
+void SyntheticInterface::setActiveWindow(const WindowId &wid)
+{
+    WindowKey previousKey(m_activeWindow);
+    WindowKey key(wid);
+
+    if (m_windows.contains(previousKey)) {
+        m_windows[previousKey].setIsActive(false);
+    }
+
+    if (m_windows.contains(key)) {
+        m_windows[key].setIsActive(true);
+    }
+
+    m_activeWindow = wid;
+    emit activeWindowChanged(wid);
+}
+
+void SyntheticInterface::updateWindow(const WindowId &wid, const WindowInfoWrap &winfo, const WindowProperties &properties)
+{
+    m_windows[wid] = winfo;
+
+    //! synthetic events are not delayed, consumers must handle the raw events rate
+    emit windowChanged(wid, properties);
+}
+
+}
+}
@@ -0,0 +1,133 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SYNTHETICINTERFACE_H
+#define SYNTHETICINTERFACE_H
+
+// local
+#include "wm/abstractwindowinterface.h"
+#include "wm/windowinfowrap.h"
+
+// Qt
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+
+
+namespace Latte {
+namespace WindowSystem {
+
+//! Window system backend without any real windows. Windows are created and modified
+//! programmatically and the corresponding window system signals are emitted immediately,
+//! it is used in order to drive the windows trackers with reproducible scenarios
+//! e.g. for benchmarking purposes
+class SyntheticInterface : public AbstractWindowInterface
+{
+    Q_OBJECT
+
+public:
+    explicit SyntheticInterface(QObject *parent = nullptr);
+    ~SyntheticInterface() override;
+
+    void setViewExtraFlags(QObject *view, bool isPanelWindow = true, Latte::Types::Visibility mode = Latte::Types::WindowsGoBelow) override;
+    void setViewStruts(QWindow &view, const QRect &rect
+                       , Plasma::Types::Location location) override;
+    void setWindowOnActivities(QWindow &view, const QStringList &activities) override;
+
+    void removeViewStruts(QWindow &view) override;
+
+    WindowId activeWindow() override;
+    WindowInfoWrap requestInfo(WindowId wid) override;
+    WindowInfoWrap requestInfoActive() override;
+
+    void skipTaskBar(const QDialog &dialog) override;
+    void slideWindow(QWindow &view, Slide location) override;
+    void enableBlurBehind(QWindow &view) override;
+
+    void requestActivate(WindowId wid) override;
+    void requestClose(WindowId wid) override;
+    void requestMoveWindow(WindowId wid, QPoint from) override;
+    void requestToggleIsOnAllDesktops(WindowId wid) override;
+    void requestToggleKeepAbove(WindowId wid) override;
+    void requestToggleMinimized(WindowId wid) override;
+    void requestToggleMaximized(WindowId wid) override;
+    void setKeepAbove(WindowId wid, bool active) override;
+    void setKeepBelow(WindowId wid, bool active) override;
+
+    bool windowCanBeDragged(WindowId wid) override;
+    bool windowCanBeMaximized(WindowId wid) override;
+
+    QIcon iconFor(WindowId wid) override;
+    WindowId winIdFor(QString appId, QRect geometry) override;
+    WindowId winIdFor(QString appId, QString title) override;
+
+    AppData appDataFor(WindowId wid) override;
+
+    void setActiveEdge(QWindow *view, bool active) override;
+
+    void switchToNextVirtualDesktop() override;
+    void switchToPreviousVirtualDesktop() override;
+
+    void setFrameExtents(QWindow *view, const QMargins &margins) override;
+    void setInputMask(QWindow *window, const QRect &rect) override;
+
+    //! Synthetic windows management
+    QList<WindowId> windows() const;
+    QStringList desktops() const;
+    void setDesktopsCount(int count);
+    //! unknown desktops are added to the synthetic desktops
+    void setCurrentDesktop(const QString &desktop);
+    void setCurrentActivity(const QString &activity);
+
+    //! empty desktop or activities mean that the window is shown on all of them
+    WindowId createWindow(const QString &appName,
+                          const QRect &geometry,
+                          const QString &desktop = QString(),
+                          const QStringList &activities = QStringList());
+    void closeWindow(const WindowId &wid);
+    void moveWindow(const WindowId &wid, const QRect &geometry);
+    void setWindowTitle(const WindowId &wid, const QString &title);
+    void setMaximized(const WindowId &wid, bool maximized);
+    void setMinimized(const WindowId &wid, bool minimized);
+    void activateWindow(const WindowId &wid);
+
+    //! raw window system events, window information is used as provided, e.g. from recorded traces
+    void addWindow(const WindowInfoWrap &winfo);
+    void changeWindow(const WindowInfoWrap &winfo, const WindowProperties &properties);
+    void removeWindow(const WindowId &wid);
+    void setActiveWindow(const WindowId &wid);
+
+private:
+    void updateWindow(const WindowId &wid, const WindowInfoWrap &winfo, const WindowProperties &properties);
+
+private:
+    quint64 m_nextWindowId{1};
+
+    WindowId m_activeWindow;
+    QStringList m_desktops;
+
+    QHash<WindowKey, WindowInfoWrap> m_windows;
+    //! geometries that are restored when windows are unmaximized
+    QHash<WindowKey, QRect> m_restoreGeometries;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// local
+#include "tracereplayer.h"
+#include "syntheticinterface.h"
+
+// Qt
+#include <QCommandLineParser>
+#include <QGuiApplication>
+#include <QStandardPaths>
+#include <QTimer>
+
+// C++
+#include <cstdlib>
+
+//! replays a windows events trace recorded with "latte-dock --record-trace" against
+//! the windows tracker, headless and without any Latte instance involved
+int main(int argc, char **argv)
+{
+    //! the synthetic window system does not need a display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app(argc, argv);
+    app.setApplicationName(QStringLiteral("latte-tracereplay"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Replays a Latte windows events trace and reports the windows tracker timings"));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("trace"), QStringLiteral("Trace file recorded with latte-dock --record-trace"));
+    parser.addOption(QCommandLineOption(QStringLiteral("realtime"), QStringLiteral("Replay the trace with its recorded timing")));
+    parser.process(app);
+
+    if (parser.positionalArguments().count() != 1) {
+        parser.showHelp(EXIT_FAILURE);
+    }
+
+    //! do not touch the user's color schemes or settings
+    QStandardPaths::setTestModeEnabled(true);
+
+    auto wm = new Latte::WindowSystem::SyntheticInterface(&app);
+    auto replayer = new Latte::WindowSystem::Tracker::TraceReplayer(wm, &app);
+
+    if (!replayer->load(parser.positionalArguments().first())) {
+        return EXIT_FAILURE;
+    }
+
+    replayer->setRealTime(parser.isSet(QStringLiteral("realtime")));
+
+    QObject::connect(replayer, &Latte::WindowSystem::Tracker::TraceReplayer::finished, &app, &QCoreApplication::quit);
+    QTimer::singleShot(0, replayer, &Latte::WindowSystem::Tracker::TraceReplayer::replay);
+
+    return app.exec();
+}
@@ -0,0 +1,255 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "tracereplayer.h"
+
+// local
+#include "syntheticinterface.h"
+#include "wm/tracerecorder.h"
+#include "wm/tracker/windowstracker.h"
+
+// Qt
+#include <QDataStream>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QTextStream>
+#include <QTimer>
+
+// C++
+#include <ctime>
+
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! events that are closer than the windows tracker batching interval are replayed together
+const int BATCHEDEVENTSINTERVAL = 16;
+//! a batch that is not finished during that time is considered lost
+const int EVENTSBATCHTIMEOUT = 1000;
+
+TraceReplayer::TraceReplayer(SyntheticInterface *wm, QObject *parent)
+    : QObject(parent),
+      m_wm(wm),
+      m_tracker(wm->windowsTracker())
+{
+    connect(m_tracker, &Windows::eventsBatchFinished, this, [&]() {
+        m_batches++;
+        m_trackerDuration += m_tracker->lastEventsBatchDuration();
+    });
+}
+
+TraceReplayer::~TraceReplayer()
+{
+}
+
+bool TraceReplayer::realTime() const
+{
+    return m_realTime;
+}
+
+void TraceReplayer::setRealTime(bool realTime)
+{
+    m_realTime = realTime;
+}
+
+bool TraceReplayer::load(const QString &file)
+{
+    QFile traceFile(file);
+
+    if (!traceFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "Window system events trace can not be read from :" << file;
+        return false;
+    }
+
+    QDataStream in(&traceFile);
+    in.setVersion(Trace::STREAMVERSION);
+
+    quint32 magic;
+    quint16 version;
+    in >> magic >> version;
+
+    if (magic != Trace::MAGIC || version > Trace::VERSION) {
+        qWarning() << "Window system events trace is not supported :" << file;
+        return false;
+    }
+
+    m_file = file;
+    m_records.clear();
+
+    while (!in.atEnd()) {
+        Record record;
+        in >> record.type >> record.timestamp;
+
+        switch (record.type) {
+        case Trace::WindowAddedEvent:
+            in >> record.info;
+            break;
+        case Trace::WindowChangedEvent: {
+            quint8 properties;
+            in >> properties >> record.info;
+            record.properties = WindowProperties(properties);
+            break;
+        }
+        case Trace::WindowRemovedEvent:
+        case Trace::ActiveWindowChangedEvent: {
+            quint64 wid;
+            in >> wid;
+            //! null window ids are kept invalid as they are provided from the window interfaces
+            record.wid = wid > 0 ? WindowId(static_cast<qulonglong>(wid)) : WindowId();
+            break;
+        }
+        case Trace::CurrentDesktopChangedEvent:
+        case Trace::CurrentActivityChangedEvent:
+            in >> record.value;
+            break;
+        default:
+            qWarning() << "Window system events trace contains unknown events :" << file;
+            return false;
+        }
+
+        if (in.status() != QDataStream::Ok) {
+            qWarning() << "Window system events trace is truncated, events loaded :" << m_records.count();
+            break;
+        }
+
+        m_records << record;
+    }
+
+    return true;
+}
+
+void TraceReplayer::replay()
+{
+    m_batches = 0;
+    m_trackerDuration = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    std::clock_t cpuStart = std::clock();
+
+    for (int i=0; i<m_records.count(); ++i) {
+        const Record &record = m_records[i];
+
+        if (m_realTime) {
+            wait(record.timestamp - timer.elapsed());
+            apply(record);
+            continue;
+        }
+
+        apply(record);
+
+        bool lastOfBatch = (i == m_records.count() - 1)
+                || ((m_records[i + 1].timestamp - record.timestamp) >= BATCHEDEVENTSINTERVAL);
+
+        if (lastOfBatch) {
+            m_tracker->flushEventsBatch();
+        }
+    }
+
+    if (m_realTime) {
+        waitForEventsBatch();
+    }
+
+    qint64 cpuTime = static_cast<qint64>((std::clock() - cpuStart) * (1000000000.0 / CLOCKS_PER_SEC));
+
+    printReport(timer.nsecsElapsed(), cpuTime);
+
+    emit finished();
+}
+
+void TraceReplayer::apply(const Record &record)
+{
+    switch (record.type) {
+    case Trace::WindowAddedEvent:
+        m_wm->addWindow(record.info);
+        break;
+    case Trace::WindowChangedEvent:
+        m_wm->changeWindow(record.info, record.properties);
+        break;
+    case Trace::WindowRemovedEvent:
+        m_wm->removeWindow(record.wid);
+        break;
+    case Trace::ActiveWindowChangedEvent:
+        m_wm->setActiveWindow(record.wid);
+        break;
+    case Trace::CurrentDesktopChangedEvent:
+        m_wm->setCurrentDesktop(record.value);
+        break;
+    case Trace::CurrentActivityChangedEvent:
+        m_wm->setCurrentActivity(record.value);
+        break;
+    default:
+        break;
+    }
+}
+
+void TraceReplayer::wait(int msecs)
+{
+    if (msecs <= 0) {
+        return;
+    }
+
+    QEventLoop loop;
+    QTimer::singleShot(msecs, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+bool TraceReplayer::waitForEventsBatch()
+{
+    QEventLoop loop;
+    QTimer timeout;
+    bool finished{false};
+
+    timeout.setSingleShot(true);
+    timeout.setInterval(EVENTSBATCHTIMEOUT);
+
+    connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+    connect(m_tracker, &Windows::eventsBatchFinished, &loop, [&]() {
+        finished = true;
+        loop.quit();
+    });
+
+    timeout.start();
+    loop.exec();
+
+    return finished;
+}
+
+void TraceReplayer::printReport(qint64 wallTime, qint64 cpuTime) const
+{
+    QTextStream out(stdout);
+
+    out << "Latte windows tracker trace replay" << endl
+        << "  trace: " << m_file << endl
+        << "  mode: " << (m_realTime ? "real time" : "as fast as possible") << endl
+        << "  events: " << m_records.count()
+        << ", duration: " << (m_records.isEmpty() ? 0 : m_records.last().timestamp) << "ms" << endl
+        << "  batches: " << m_batches
+        << ", tracked windows: " << m_tracker->windows().count() << endl
+        << "  wall time: " << wallTime / 1000 << "us"
+        << ", process cpu time: " << cpuTime / 1000 << "us"
+        << ", tracker time: " << m_trackerDuration / 1000 << "us" << endl;
+}
+
+}
+}
+}
@@ -0,0 +1,103 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMTRACKERTRACEREPLAYER_H
+#define WINDOWSYSTEMTRACKERTRACEREPLAYER_H
+
+// local
+#include "wm/windowinfowrap.h"
+
+// Qt
+#include <QList>
+#include <QObject>
+#include <QString>
+
+namespace Latte {
+namespace WindowSystem {
+class SyntheticInterface;
+namespace Tracker {
+class Windows;
+}
+}
+}
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! Feeds a recorded window system events trace into the windows tracker through
+//! the synthetic window system and reports the time the tracker spent for it.
+//! Events are replayed either in real time or as fast as possible, in the latter
+//! case the idle time between events is skipped but the events that were close
+//! enough to be evaluated together are still provided together. It runs headless,
+//! without any views or layouts, from the latte-tracereplay tool, so it measures
+//! the window information tracking and not the views hints evaluation
+class TraceReplayer : public QObject {
+    Q_OBJECT
+
+public:
+    TraceReplayer(SyntheticInterface *wm, QObject *parent = nullptr);
+    ~TraceReplayer() override;
+
+    bool load(const QString &file);
+
+    bool realTime() const;
+    void setRealTime(bool realTime);
+
+public slots:
+    void replay();
+
+signals:
+    void finished();
+
+private:
+    struct Record
+    {
+        quint8 type{0};
+        quint32 timestamp{0};
+        WindowProperties properties{AllWindowProperties};
+        WindowInfoWrap info;
+        WindowId wid;
+        QString value;
+    };
+
+    void apply(const Record &record);
+    void wait(int msecs);
+    bool waitForEventsBatch();
+
+    void printReport(qint64 wallTime, qint64 cpuTime) const;
+
+private:
+    bool m_realTime{false};
+
+    int m_batches{0};
+    qint64 m_trackerDuration{0};
+
+    QString m_file;
+    QList<Record> m_records;
+
+    SyntheticInterface *m_wm{nullptr};
+    Windows *m_tracker{nullptr};
+};
+
+}
+}
+}
+
+#endif
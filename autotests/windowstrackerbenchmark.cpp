@@ -0,0 +1,334 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// local
+#include "syntheticinterface.h"
+#include "wm/tracker/windowstracker.h"
+
+// Qt
+#include <QDebug>
+#include <QGuiApplication>
+#include <QRandomGenerator>
+#include <QScreen>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QtTest>
+
+using namespace Latte::WindowSystem;
+
+//! windows that are present while the events scenarios are measured
+const int WINDOWS = 200;
+const int DESKTOPS = 4;
+const int BURSTEVENTS = 100;
+//! thickness of the synthetic views
+const int VIEWTHICKNESS = 48;
+
+//! Drives the windows tracker through the synthetic window system with reproducible
+//! scenarios. Events batches are flushed immediately, so only the tracking cost is
+//! measured and not the batching interval. Synthetic views are placed at the screen
+//! edges in order to measure also the windows hints evaluation
+class WindowsTrackerBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void populate_data();
+    void populate();
+    void singleEvent_data();
+    void singleEvent();
+    void burstEvents_data();
+    void burstEvents();
+    void desktopSwitch_data();
+    void desktopSwitch();
+
+private:
+    void addViewsColumn();
+    void createViews(int count);
+    void reportHintsEvaluated(quint64 hintsBefore, int iterations) const;
+
+    QList<WindowId> createWindows(int count);
+    void closeWindows(const QList<WindowId> &windows);
+
+    void applyRandomEvent();
+
+    int random(int max);
+    QRect randomGeometry();
+
+private:
+    int m_titlesCount{0};
+
+    //! seeded in order to replay the same scenarios in every run
+    QRandomGenerator m_random{1};
+
+    QList<WindowId> m_windows;
+
+    SyntheticInterface *m_wm{nullptr};
+    Tracker::Windows *m_tracker{nullptr};
+};
+
+void WindowsTrackerBenchmark::initTestCase()
+{
+    //! application identities cache must not touch the user cache
+    QStandardPaths::setTestModeEnabled(true);
+
+    m_wm = new SyntheticInterface(this);
+    m_wm->setDesktopsCount(DESKTOPS);
+    m_tracker = m_wm->windowsTracker();
+
+    QSignalSpy batchSpy(m_tracker, &Tracker::Windows::eventsBatchFinished);
+
+    m_windows = createWindows(WINDOWS);
+    m_tracker->flushEventsBatch();
+
+    QCOMPARE(batchSpy.count(), 1);
+    QCOMPARE(m_tracker->windows().count(), WINDOWS);
+}
+
+void WindowsTrackerBenchmark::cleanupTestCase()
+{
+    closeWindows(m_windows);
+    m_tracker->flushEventsBatch();
+
+    QVERIFY(m_tracker->windows().isEmpty());
+
+    delete m_wm;
+    m_wm = nullptr;
+}
+
+void WindowsTrackerBenchmark::populate_data()
+{
+    QTest::addColumn<int>("windows");
+
+    QTest::newRow("50 windows") << 50;
+    QTest::newRow("200 windows") << 200;
+    QTest::newRow("1000 windows") << 1000;
+}
+
+void WindowsTrackerBenchmark::populate()
+{
+    QFETCH(int, windows);
+
+    QBENCHMARK {
+        QList<WindowId> created = createWindows(windows);
+        m_tracker->flushEventsBatch();
+
+        closeWindows(created);
+        m_tracker->flushEventsBatch();
+    }
+}
+
+void WindowsTrackerBenchmark::singleEvent_data()
+{
+    addViewsColumn();
+}
+
+void WindowsTrackerBenchmark::singleEvent()
+{
+    QFETCH(int, views);
+
+    createViews(views);
+    quint64 hints = m_tracker->hintsEvaluated();
+    int iterations{0};
+
+    QBENCHMARK {
+        applyRandomEvent();
+        m_tracker->flushEventsBatch();
+        ++iterations;
+    }
+
+    reportHintsEvaluated(hints, iterations);
+    m_tracker->removeSyntheticViews();
+}
+
+void WindowsTrackerBenchmark::burstEvents_data()
+{
+    addViewsColumn();
+}
+
+void WindowsTrackerBenchmark::burstEvents()
+{
+    QFETCH(int, views);
+
+    createViews(views);
+    quint64 hints = m_tracker->hintsEvaluated();
+    int iterations{0};
+
+    QBENCHMARK {
+        for (int i=0; i<BURSTEVENTS; ++i) {
+            applyRandomEvent();
+        }
+
+        m_tracker->flushEventsBatch();
+        ++iterations;
+    }
+
+    reportHintsEvaluated(hints, iterations);
+    m_tracker->removeSyntheticViews();
+}
+
+void WindowsTrackerBenchmark::desktopSwitch_data()
+{
+    addViewsColumn();
+}
+
+void WindowsTrackerBenchmark::desktopSwitch()
+{
+    QFETCH(int, views);
+
+    createViews(views);
+    quint64 hints = m_tracker->hintsEvaluated();
+    int iterations{0};
+
+    QBENCHMARK {
+        m_wm->switchToNextVirtualDesktop();
+        m_tracker->flushEventsBatch();
+        ++iterations;
+    }
+
+    reportHintsEvaluated(hints, iterations);
+    m_tracker->removeSyntheticViews();
+}
+
+void WindowsTrackerBenchmark::addViewsColumn()
+{
+    QTest::addColumn<int>("views");
+
+    QTest::newRow("no views") << 0;
+    QTest::newRow("4 views") << 4;
+    QTest::newRow("16 views") << 16;
+}
+
+void WindowsTrackerBenchmark::createViews(int count)
+{
+    QList<QScreen *> screens = qGuiApp->screens();
+    QRect screen = screens.isEmpty() ? QRect(0, 0, 800, 600) : screens[0]->geometry();
+
+    //! views are distributed to all screen edges and views of the same edge split its length
+    const QList<Plasma::Types::Location> edges{Plasma::Types::BottomEdge, Plasma::Types::LeftEdge,
+                                               Plasma::Types::TopEdge, Plasma::Types::RightEdge};
+    int segments = qMax(1, (count + edges.count() - 1) / edges.count());
+
+    for (int i=0; i<count; ++i) {
+        Plasma::Types::Location edge = edges[i % edges.count()];
+        int segment = i / edges.count();
+        QRect geometry;
+
+        if (edge == Plasma::Types::BottomEdge || edge == Plasma::Types::TopEdge) {
+            int length = screen.width() / segments;
+            int y = (edge == Plasma::Types::TopEdge) ? screen.top() : screen.bottom() - VIEWTHICKNESS + 1;
+            geometry = QRect(screen.x() + segment * length, y, length, VIEWTHICKNESS);
+        } else {
+            int length = screen.height() / segments;
+            int x = (edge == Plasma::Types::LeftEdge) ? screen.left() : screen.right() - VIEWTHICKNESS + 1;
+            geometry = QRect(x, screen.y() + segment * length, VIEWTHICKNESS, length);
+        }
+
+        m_tracker->addSyntheticView(geometry, screen, edge);
+    }
+}
+
+void WindowsTrackerBenchmark::reportHintsEvaluated(quint64 hintsBefore, int iterations) const
+{
+    qDebug() << "hints evaluations per iteration :" << (m_tracker->hintsEvaluated() - hintsBefore) / quint64(qMax(1, iterations));
+}
+
+QList<WindowId> WindowsTrackerBenchmark::createWindows(int count)
+{
+    QList<WindowId> windows;
+
+    for (int i=0; i<count; ++i) {
+        QString desktop = m_wm->desktops()[i % m_wm->desktops().count()];
+        windows << m_wm->createWindow(QStringLiteral("synthetic-app-%1").arg(i % 16), randomGeometry(), desktop);
+    }
+
+    return windows;
+}
+
+void WindowsTrackerBenchmark::closeWindows(const QList<WindowId> &windows)
+{
+    for (const auto &wid : windows) {
+        m_wm->closeWindow(wid);
+    }
+}
+
+void WindowsTrackerBenchmark::applyRandomEvent()
+{
+    int index = random(m_windows.count());
+    WindowId wid = m_windows[index];
+    WindowInfoWrap winfo = m_wm->requestInfo(wid);
+
+    //! every event must change the window state in order to produce a window system event
+    switch (random(5)) {
+    case 0: {
+        QRect geometry = randomGeometry();
+        m_wm->moveWindow(wid, geometry != winfo.geometry() ? geometry : geometry.translated(1, 1));
+        break;
+    }
+    case 1:
+        m_wm->setMaximized(wid, !winfo.isMaximized());
+        break;
+    case 2:
+        m_wm->setMinimized(wid, !winfo.isMinimized());
+        break;
+    case 3:
+        if (winfo.isActive()) {
+            wid = m_windows[(index + 1) % m_windows.count()];
+        }
+
+        if (m_wm->activeWindow() != wid) {
+            m_wm->activateWindow(wid);
+        } else {
+            m_wm->setMinimized(wid, true);
+        }
+        break;
+    default:
+        m_wm->setWindowTitle(wid, QStringLiteral("%1 - %2").arg(winfo.appName()).arg(++m_titlesCount));
+        break;
+    }
+}
+
+int WindowsTrackerBenchmark::random(int max)
+{
+    return max > 0 ? m_random.bounded(max) : 0;
+}
+
+QRect WindowsTrackerBenchmark::randomGeometry()
+{
+    QList<QScreen *> screens = qGuiApp->screens();
+
+    if (screens.isEmpty()) {
+        return QRect(0, 0, 800, 600);
+    }
+
+    QRect available = screens[random(screens.count())]->availableGeometry();
+
+    int width = available.width() / 4 + random(available.width() * 3 / 4);
+    int height = available.height() / 4 + random(available.height() * 3 / 4);
+    int x = available.x() + random(available.width() - width + 1);
+    int y = available.y() + random(available.height() - height + 1);
+
+    return QRect(x, y, width, height);
+}
+
+QTEST_MAIN(WindowsTrackerBenchmark)
+
+#include "windowstrackerbenchmark.moc"